@@ -0,0 +1,34 @@
+
+//
+// benchmark.cpp - Euchre benchmark entry point
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <cstdlib>
+#include <iostream>
+
+#include "euchre_benchmark.h"
+
+// euchre benchmark entry point. prints one csv line per benchmark, with the nanoseconds per
+// operation over the timed repetitions.
+//
+// usage:
+//   euchre_bench [repetitions] [min_repetition_ms]
+int main(int argc, char *argv[])
+{
+    rda::euchre::euchre_benchmark_settings settings;
+
+    if (argc >= 2)
+        settings.repetitions = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+
+    if (argc >= 3)
+        settings.min_repetition_ms = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+
+    std::cout << rda::euchre::euchre_benchmark_result::csv_header() << std::endl;
+
+    for (auto &result : rda::euchre::run_benchmark_suite(settings))
+        std::cout << result.to_string() << std::endl;
+
+    return 0;
+}
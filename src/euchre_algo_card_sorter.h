@@ -7,13 +7,22 @@
 //
 
 #include <algorithm>
-#include <map>
+#include <array>
+#include <cstdint>
 #include <random>
 #include <vector>
 
+#include "platform_defs.h"
+
+#include "euchre_algo_trick.h"
 #include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_constants.h"
 #include "random_seeder.h"
 
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
 namespace rda
 {
     namespace euchre
@@ -38,6 +47,86 @@ namespace rda
                 }
             }
 
+            // order of the cards when sorted by suit, under each trump suit (and no trump): the
+            // right bower, the left bower, the rest of trump, then the other suits in suit order,
+            // each from highest to lowest
+            struct card_order_table
+            {
+                // position of each card index in the sorted deck (0 is first), by trump suit
+                uint8_t position[euchre_constants::NUM_SUITS + 1][euchre_constants::NUM_CARDS];
+
+                // card index at each position of the sorted deck, by trump suit
+                uint8_t card[euchre_constants::NUM_SUITS + 1][euchre_constants::NUM_CARDS];
+            };
+
+            // returns a key that sorts a card index under a trump suit index (NUM_SUITS for no
+            // trump). lower keys come first.
+            constexpr uint8_t card_sort_key(const uint8_t trump, const uint8_t index)
+            {
+                const uint8_t suit = index / euchre_constants::NUM_RANKS;
+                const uint8_t rank = index % euchre_constants::NUM_RANKS;
+                const uint8_t jack = static_cast<uint8_t>(e_rank::JACK) - static_cast<uint8_t>(e_rank::BEGIN);
+
+                // right bower, then left bower (suits of the same color are 0 and 3, 1 and 2)
+                if (suit == trump && rank == jack)
+                    return 0;
+
+                if (trump < euchre_constants::NUM_SUITS && suit == 3 - trump && rank == jack)
+                    return 1;
+
+                // the rest of trump, from the ace down (skipping the jack)
+                if (suit == trump)
+                    return 2 + ((rank > jack) ? euchre_constants::NUM_RANKS - 1 - rank : euchre_constants::NUM_RANKS - 2 - rank);
+
+                return 7 + suit * euchre_constants::NUM_RANKS + (euchre_constants::NUM_RANKS - 1 - rank);
+            }
+
+            // build the table of the sorted order of the cards under every trump suit
+            constexpr card_order_table make_card_order_table()
+            {
+                card_order_table t{};
+
+                for (uint8_t trump = 0; trump <= euchre_constants::NUM_SUITS; ++trump)
+                {
+                    for (uint8_t index = 0; index < euchre_constants::NUM_CARDS; ++index)
+                    {
+                        uint8_t position = 0;
+
+                        for (uint8_t other = 0; other < euchre_constants::NUM_CARDS; ++other)
+                            if (card_sort_key(trump, other) < card_sort_key(trump, index))
+                                ++position;
+
+                        t.position[trump][index] = position;
+                        t.card[trump][position] = index;
+                    }
+                }
+
+                return t;
+            }
+
+            // the sorted order of the cards under every trump suit, computed at compile time
+            constexpr card_order_table CARD_ORDER = make_card_order_table();
+
+            static_assert(CARD_ORDER.card[static_cast<uint8_t>(e_suit::HEARTS)][1] == static_cast<uint8_t>(e_suit::DIAMONDS) * euchre_constants::NUM_RANKS + 2,
+                          "the left bower sorts second");
+
+            // returns the row of CARD_ORDER for a trump suit
+            static uint8_t card_order_row(const e_suit trump_suit)
+            {
+                return (trump_suit < e_suit::END) ? static_cast<uint8_t>(trump_suit) : static_cast<uint8_t>(euchre_constants::NUM_SUITS);
+            }
+
+            // returns the position of a card in the deck sorted by suit (invalid cards sort last)
+            static uint8_t sort_position(const euchre_card &card, const e_suit trump_suit)
+            {
+                const uint8_t index = euchre_mask::card_index(card);
+
+                if (index >= euchre_constants::NUM_CARDS)
+                    return euchre_constants::NUM_CARDS;
+
+                return CARD_ORDER.position[card_order_row(trump_suit)][index];
+            }
+
             // returns a sorted vector of cards of a trump shit
             static std::vector<euchre_card> get_trump_deck(const e_suit trump_suit)
             {
@@ -99,16 +188,20 @@ namespace rda
                 // the trump suit
                 e_suit trump_suit = e_suit::INVALID;
 
-                // count of trump suits
-                std::map<e_suit, uint8_t> suit_counts;
+                // count of cards of each effective suit
+                std::array<uint8_t, euchre_constants::NUM_SUITS> suit_counts{};
 
                 // constructor
                 deck_metrics(const e_suit trump, const std::vector<euchre_card> &deck)
                     : trump_suit(trump)
                 {
-                    std::for_each(deck.cbegin(), deck.cend(), [this](auto &c) {
-                        this->suit_counts[get_effective_suit(c, this->trump_suit)]++;
-                    });
+                    for (auto &c : deck)
+                    {
+                        const e_suit suit = get_effective_suit(c, trump_suit);
+
+                        if (suit < e_suit::END)
+                            ++suit_counts[static_cast<uint8_t>(suit)];
+                    }
                 }
             };
 
@@ -128,63 +221,113 @@ namespace rda
             class card_comp_by_suit
             {
             private:
-                const deck_metrics &metrics;
+                // the trump suit
+                e_suit trump_suit;
 
             public:
+                card_comp_by_suit(const e_suit trump)
+                    : trump_suit(trump)
+                {
+                }
+
                 card_comp_by_suit(const deck_metrics &dm)
-                    : metrics(dm)
+                    : trump_suit(dm.trump_suit)
                 {
                 }
 
                 // returns true if c1 comes before c2 in the sort
                 bool operator()(const euchre_card &c1, const euchre_card &c2) const
                 {
-                    // if the cards are equal, just return
-                    if (c1 == c2)
-                        return false;
+                    return sort_position(c1, trump_suit) < sort_position(c2, trump_suit);
+                }
+            };
 
-                    // right bower is always first
-                    if (is_right_bower(c1, metrics.trump_suit))
-                        return true;
+            // sort a vector of cards, given a trump suit
+            static void sort_deck_by_suit(std::vector<euchre_card> &deck, const e_suit trump_suit)
+            {
+                std::sort(deck.begin(), deck.end(), card_comp_by_suit(trump_suit));
+            }
 
-                    if (is_right_bower(c2, metrics.trump_suit))
-                        return false;
+            // returns the index (into cards_played) of the card that wins the trick
+            static size_t trick_winner(const std::vector<euchre_card> &cards_played, const e_suit trump_suit)
+            {
+                if (cards_played.empty())
+                    return 0;
 
-                    // left bower comes before any card except the right bower
-                    if (is_left_bower(c1, metrics.trump_suit))
-                        return true;
+                const trick_table &table = get_trick_table(trump_suit);
+                const auto &power = table.power[static_cast<uint8_t>(table.effective_suit[euchre_mask::card_index(cards_played.front())])];
 
-                    if (is_left_bower(c2, metrics.trump_suit))
-                        return false;
+                size_t winner = 0;
 
-                    // both cards are trump, return true if c1 is higher trump
-                    if (c1.suit() == metrics.trump_suit && c2.suit() == metrics.trump_suit)
-                        return c1.rank() > c2.rank();
+                for (size_t i = 1; i < cards_played.size(); ++i)
+                    if (power[euchre_mask::card_index(cards_played[i])] > power[euchre_mask::card_index(cards_played[winner])])
+                        winner = i;
 
-                    // if only c1 is trump, return true since c1 is higher
-                    if (c1.suit() == metrics.trump_suit)
-                        return true;
+                return winner;
+            }
 
-                    // if only c2 is trump, return false, since c2 is higher
-                    if (c2.suit() == metrics.trump_suit)
-                        return false;
+            // returns the mask of the cards in a deck
+            static euchre_card_mask deck_mask(const std::vector<euchre_card> &deck)
+            {
+                euchre_card_mask m = euchre_mask::EMPTY;
+
+                for (auto &c : deck)
+                    m |= euchre_mask::card_bit(c);
+
+                return m;
+            }
+
+            // returns the cards of "cards" whose effective suit is "suit", except those in "except"
+            static euchre_card_mask cards_of_suit(const euchre_card_mask cards,
+                                                  const e_suit suit,
+                                                  const e_suit trump_suit,
+                                                  const euchre_card_mask except = euchre_mask::EMPTY)
+            {
+                if (suit >= e_suit::END)
+                    return euchre_mask::EMPTY;
+
+                return cards & get_trick_table(trump_suit).suit_cards[static_cast<uint8_t>(suit)] & ~except;
+            }
+
+            // returns the card of "cards" that sorts first (the highest trump, or else the highest
+            // card of the lowest suit), or an invalid card if there are none
+            static euchre_card highest_card(const euchre_card_mask cards, const e_suit trump_suit)
+            {
+                if (cards == euchre_mask::EMPTY)
+                    return euchre_card();
 
-                    // if suits are not the same
-                    if (c1.suit() != c2.suit())
-                        return c1.suit() < c2.suit();
+                const euchre_card_mask trump_cards = cards & euchre_mask::trump_mask(trump_suit);
 
-                    // if suits are the same, just compare ranks
-                    return c1.rank() > c2.rank();
+                if (trump_cards != euchre_mask::EMPTY)
+                {
+                    // the bowers, then the rest of trump by rank (the bit order within a suit)
+                    if (trump_cards & euchre_mask::right_bower_mask(trump_suit))
+                        return euchre_card(trump_suit, e_rank::JACK);
+
+                    if (trump_cards & euchre_mask::left_bower_mask(trump_suit))
+                        return euchre_card(euchre_mask::same_color_suit(trump_suit), e_rank::JACK);
+
+                    return euchre_mask::card_from_index(euchre_mask::highest_index(trump_cards));
                 }
-            };
 
-            // sort a vector of cards, given a trump suit
-            static void sort_deck_by_suit(std::vector<euchre_card> &deck, const e_suit trump_suit)
+                // the lowest suit present, then the highest rank in it
+                const uint8_t suit = euchre_mask::lowest_index(cards) / euchre_constants::NUM_RANKS;
+
+                return euchre_mask::card_from_index(euchre_mask::highest_index(cards & euchre_mask::suit_mask(static_cast<e_suit>(suit))));
+            }
+
+            // write the cards of "cards" to "out" in sorted order, and return how many were written
+            static uint8_t sorted_cards(const euchre_card_mask cards,
+                                        const e_suit trump_suit,
+                                        std::array<euchre_card, euchre_constants::NUM_CARDS> &out)
             {
-                // create metrics for the deck
-                const deck_metrics dm(trump_suit, deck);
-                // sort the deck
-                std::sort(deck.begin(), deck.end(), card_comp_by_suit(dm));
+                uint8_t count = 0;
+
+                for (auto &index : CARD_ORDER.card[card_order_row(trump_suit)])
+                    if (cards & (euchre_card_mask(1) << index))
+                        out[count++] = euchre_mask::card_from_index(index);
+
+                return count;
             }
 
             // returns sorted vector of highest cards in deck, of a given suit, with given trump suit, and possibly excluding cards.
@@ -193,29 +336,10 @@ namespace rda
                                                                   const e_suit trump_suit,
                                                                   const std::vector<euchre_card> &except = {})
             {
-                // make a copy of the input deck
-                auto deck(input_deck);
-
-                // erase all excluded cards, and cards not matching effective suit
-                deck.erase(std::remove_if(deck.begin(), deck.end(),
-                                          [=](auto &c) {
-                                              // if is in list of exclusions, remove it
-                                              if (std::find(except.cbegin(), except.cend(), c) != except.cend())
-                                                  return true;
-
-                                              // if the suit doesn't match, remove it
-                                              if (get_effective_suit(c, trump_suit) != suit)
-                                                  return true;
-
-                                              // else, keep it
-                                              return false;
-                                          }),
-                           deck.end());
+                std::array<euchre_card, euchre_constants::NUM_CARDS> cards;
+                const uint8_t count = sorted_cards(cards_of_suit(deck_mask(input_deck), suit, trump_suit, deck_mask(except)), trump_suit, cards);
 
-                // sort the deck
-                sort_deck_by_suit(deck, trump_suit);
-
-                return deck;
+                return std::vector<euchre_card>(cards.cbegin(), cards.cbegin() + count);
             }
 
             // returns highest card in deck, of a given suit, with given trump suit, and possibly excluding cards.
@@ -224,12 +348,7 @@ namespace rda
                                                     const e_suit trump_suit,
                                                     const std::vector<euchre_card> &except = {})
             {
-                auto deck = highest_cards_in_deck(input_deck, suit, trump_suit, except);
-
-                if (!deck.empty())
-                    return deck.front();
-
-                return euchre_card();
+                return highest_card(cards_of_suit(deck_mask(input_deck), suit, trump_suit, deck_mask(except)), trump_suit);
             }
 
         } // namespace euchre_algo
@@ -237,3 +356,5 @@ namespace rda
     } // namespace euchre
 
 } // namespace rda
+
+POP_WARN_DISABLE
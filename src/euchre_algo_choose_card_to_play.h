@@ -7,14 +7,25 @@
 //
 
 #include <algorithm>
+#include <array>
 #include <vector>
 
+#include "platform_defs.h"
+
 #include "euchre_algo_card_sorter.h"
+#include "euchre_algo_deal_sampler.h"
+#include "euchre_algo_pimc.h"
+#include "euchre_algo_solver.h"
 #include "euchre_card.h"
+#include "euchre_card_mask.h"
 #include "euchre_hand.h"
 #include "euchre_perception.h"
 #include "euchre_utils.h"
 #include "euchre_seat_position.h"
+#include "random_seeder.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
 
 namespace rda
 {
@@ -37,7 +48,10 @@ namespace rda
                     const bool is_loner_,
                     const euchre_perception &left_perception_,
                     const euchre_perception &partner_perception_,
-                    const euchre_perception &right_perception_)
+                    const euchre_perception &right_perception_,
+                    const std::vector<euchre_card> &cards_played_by_self_,
+                    const euchre_algo::pimc_settings &settings_,
+                    euchre_random_engine &random_engine_)
                     : cards_played(cards_played_),
                       trump_suit(trump_suit_),
                       hand(hand_),
@@ -49,7 +63,10 @@ namespace rda
                       is_loner(is_loner_),
                       left_perception(left_perception_),
                       partner_perception(partner_perception_),
-                      right_perception(right_perception_)
+                      right_perception(right_perception_),
+                      cards_played_by_self(cards_played_by_self_),
+                      settings(settings_),
+                      random_engine(random_engine_)
                 {
                 }
 
@@ -88,12 +105,21 @@ namespace rda
 
                 // right-side opponent perception
                 const euchre_perception &right_perception;
+
+                // cards this player has played in earlier tricks of the hand
+                const std::vector<euchre_card> &cards_played_by_self;
+
+                // settings for choosing a card by sampling deals
+                const euchre_algo::pimc_settings settings;
+
+                // the player's random engine
+                euchre_random_engine &random_engine;
             };
 
             // predicate to check if a hand contains a card
             static bool pred_hand_contains(const euchre_algo_choose_card_to_play_context &ctx, const euchre_card &card)
             {
-                return std::find(ctx.hand_cards.cbegin(), ctx.hand.cend(), euchre_utils::right_bower(ctx.trump_suit)) != ctx.hand_cards.cend();
+                return ctx.hand.contains(card);
             }
 
             // predicate to check if this player called trump
@@ -174,16 +200,17 @@ namespace rda
 
                 // check if this hand can follow suit
                 const bool can_follow_suit = std::any_of(hand_cards.cbegin(), hand_cards.cend(),
-                                                         [ctx, suit_lead](auto &c) {
-                                                             return euchre_algo::get_effective_suit(c.suit(), trump_suit) == ctx.suit_lead;
+                                                         [&ctx, suit_lead](const euchre_card &c) {
+                                                             return euchre_algo::get_effective_suit(c, ctx.trump_suit) == suit_lead;
                                                          });
 
                 // if we can follow suit, remove all cards that aren't the suit lead
-                hand_cards.erase(std::remove_if(hand_cards.begin(), hand_cards.end(),
-                                                [ctx, suit_lead](auto &c) {
-                                                    return euchre_algo::get_effective_suit(c.suit(), trump_suit) != ctx.suit_lead;
-                                                }),
-                                 hand_cards.end());
+                if (can_follow_suit)
+                    hand_cards.erase(std::remove_if(hand_cards.begin(), hand_cards.end(),
+                                                    [&ctx, suit_lead](const euchre_card &c) {
+                                                        return euchre_algo::get_effective_suit(c, ctx.trump_suit) != suit_lead;
+                                                    }),
+                                     hand_cards.end());
 
                 // if there is only one card, return it
                 if (hand_cards.size() == 1)
@@ -196,6 +223,72 @@ namespace rda
                 return hand_cards.front();
             }
 
+            // build the position as seen by this player (only its own hand filled in) and the
+            // constraints on where the unseen cards may be
+            static void build_pimc_position(const euchre_algo_choose_card_to_play_context &ctx,
+                                            euchre_algo::solver_position &pos,
+                                            euchre_algo::deal_constraints &constraints)
+            {
+                const std::array<const euchre_perception *, 3> others = {&ctx.left_perception, &ctx.partner_perception, &ctx.right_perception};
+
+                const uint8_t seat_index = (ctx.partner_perception.seat_index + 2) % euchre_constants::NUM_PLAYERS;
+                const euchre_card_mask own_hand = ctx.hand.mask();
+
+                pos.trump_suit = ctx.trump_suit;
+
+                if (ctx.is_loner)
+                    pos.sitting_out_index = (seat_index + static_cast<uint8_t>(ctx.who_called_trump) + 2) % euchre_constants::NUM_PLAYERS;
+
+                // the leader is whoever makes this player the next to play
+                for (uint8_t leader = 0; leader < euchre_constants::NUM_PLAYERS; ++leader)
+                {
+                    pos.leader_index = leader;
+                    if (leader != pos.sitting_out_index && pos.seat_of_play(static_cast<uint8_t>(ctx.cards_played.size())) == seat_index)
+                        break;
+                }
+
+                for (auto &card : ctx.cards_played)
+                    pos.played[pos.num_played++] = euchre_mask::card_index(card);
+
+                pos.hands[seat_index] = own_hand;
+
+                // every card not held or already played by this player, and not played by anyone else
+                euchre_card_mask seen = own_hand;
+                for (auto &card : ctx.cards_played_by_self)
+                    seen |= euchre_mask::card_bit(card);
+                for (auto &p : others)
+                    seen |= p->get_cards_played_mask();
+
+                constraints.unseen = euchre_mask::FULL_DECK & ~seen;
+
+                for (auto &p : others)
+                {
+                    if (p->seat_index == pos.sitting_out_index)
+                        continue;
+
+                    // players who already played into this trick hold one card fewer
+                    bool played_this_trick = false;
+                    for (uint8_t n = 0; n < pos.num_played; ++n)
+                        played_this_trick = played_this_trick || (pos.seat_of_play(n) == p->seat_index);
+
+                    constraints.counts[p->seat_index] = static_cast<uint8_t>(ctx.hand.size() - (played_this_trick ? 1 : 0));
+                    constraints.allowed[p->seat_index] = constraints.unseen & ~p->get_cards_not_in_hand_mask();
+                    constraints.required[p->seat_index] = constraints.unseen & p->get_cards_in_hand_mask();
+                }
+            }
+
+            // choose what card to play by sampling deals of the unseen cards. returns an invalid
+            // card if no consistent deal was found.
+            static euchre_card choose_card_by_sampling(const euchre_algo_choose_card_to_play_context &ctx)
+            {
+                euchre_algo::solver_position pos;
+                euchre_algo::deal_constraints constraints;
+
+                build_pimc_position(ctx, pos, constraints);
+
+                return euchre_algo::choose_card_pimc(pos, constraints, ctx.settings, ctx.random_engine);
+            }
+
             // choose what card to play
             static euchre_card choose_card(
                 const std::vector<euchre_card> &cards_played_,
@@ -208,7 +301,10 @@ namespace rda
                 const bool is_loner_,
                 const euchre_perception &left_perception_,
                 const euchre_perception &partner_perception_,
-                const euchre_perception &right_perception_)
+                const euchre_perception &right_perception_,
+                const std::vector<euchre_card> &cards_played_by_self_ = std::vector<euchre_card>(),
+                const euchre_algo::pimc_settings &settings_ = euchre_algo::pimc_settings(),
+                euchre_random_engine &random_engine_ = get_random_engine())
 
             {
                 euchre_algo_choose_card_to_play_context ctx(
@@ -223,7 +319,10 @@ namespace rda
                     is_loner_,
                     left_perception_,
                     partner_perception_,
-                    right_perception_);
+                    right_perception_,
+                    cards_played_by_self_,
+                    settings_,
+                    random_engine_);
 
                 if (ctx.hand.empty())
                     return euchre_card();
@@ -231,7 +330,15 @@ namespace rda
                 else if (ctx.hand.size() == 1)
                     return *(ctx.hand.cbegin());
 
-                else if (ctx.cards_played.empty())
+                if (ctx.settings.num_samples > 0)
+                {
+                    const euchre_card card = choose_card_by_sampling(ctx);
+
+                    if (ctx.hand.contains(card))
+                        return card;
+                }
+
+                if (ctx.cards_played.empty())
                     return choose_card_to_lead(ctx);
 
                 else
@@ -243,3 +350,5 @@ namespace rda
     } // namespace euchre
 
 } // namespace rda
+
+POP_WARN_DISABLE
@@ -0,0 +1,223 @@
+#pragma once
+
+//
+// euchre_algo_deal_sampler.h - Sample deals of unseen cards consistent with what is known
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "euchre_card_mask.h"
+#include "euchre_constants.h"
+#include "random_seeder.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        namespace euchre_algo
+        {
+            // what is known about where the unseen cards are
+            struct deal_constraints
+            {
+                // cards whose location is unknown (in another player's hand, or not dealt)
+                euchre_card_mask unseen = euchre_mask::EMPTY;
+
+                // number of unseen cards held by each seat (0 for seats whose hand is known)
+                std::array<uint8_t, euchre_constants::NUM_PLAYERS> counts{};
+
+                // cards each seat may hold
+                std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> allowed{};
+
+                // cards each seat is known to hold
+                std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> required{};
+            };
+
+            // draws deals of the unseen cards uniformly from every deal consistent with the
+            // constraints, without rejection. the cards known to be held are placed first. then
+            // the number of ways to deal the remaining cards is counted for every combination of
+            // seat capacities left, one card at a time. each card is then dealt to a seat (or left
+            // undealt) with probability proportional to the number of ways to finish the deal.
+            // counting is done once, so every sample costs the same however constrained the
+            // position is.
+            class deal_sampler
+            {
+            private:
+                // cards known to be held by each seat
+                std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> placed{};
+
+                // cards each seat may hold
+                std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> allowed{};
+
+                // cards still to be dealt once known cards are placed
+                std::vector<uint8_t> cards;
+
+                // number of those cards each seat still needs
+                std::array<uint8_t, euchre_constants::NUM_PLAYERS> capacity{};
+
+                // state index weight of each seat's remaining capacity
+                std::array<uint32_t, euchre_constants::NUM_PLAYERS> stride{};
+
+                // number of capacity states
+                uint32_t num_states = 0;
+
+                // ways[i * num_states + state] is the number of ways to deal cards[i..] when the
+                // seats still need the capacities encoded in "state"
+                std::vector<uint64_t> ways;
+
+                // true if at least one consistent deal exists
+                bool feasible = false;
+
+            public:
+                // constructor for a sampler with no consistent deals
+                deal_sampler() = default;
+
+                // constructor. counts the consistent deals of the constraints.
+                explicit deal_sampler(const deal_constraints &constraints)
+                    : allowed(constraints.allowed)
+                {
+                    euchre_card_mask all_placed = euchre_mask::EMPTY;
+
+                    for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                    {
+                        placed[seat] = constraints.required[seat] & constraints.unseen;
+
+                        // a card can't be known to be in two hands, and a hand can't hold too many
+                        if ((all_placed & placed[seat]) || euchre_mask::popcount(placed[seat]) > constraints.counts[seat])
+                            return;
+
+                        all_placed |= placed[seat];
+                        capacity[seat] = static_cast<uint8_t>(constraints.counts[seat] - euchre_mask::popcount(placed[seat]));
+                    }
+
+                    for (euchre_card_mask m = constraints.unseen & ~all_placed; m != 0; m &= m - 1)
+                        cards.push_back(euchre_mask::lowest_index(m));
+
+                    num_states = 1;
+                    for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                    {
+                        stride[seat] = num_states;
+                        num_states *= capacity[seat] + 1u;
+                    }
+
+                    ways.assign((cards.size() + 1) * num_states, 0);
+
+                    // with no cards left, only the state where every seat is full completes a deal
+                    ways[cards.size() * num_states] = 1;
+
+                    for (size_t i = cards.size(); i-- > 0;)
+                    {
+                        for (uint32_t state = 0; state < num_states; ++state)
+                        {
+                            uint64_t count = 0;
+                            uint32_t needed = 0;
+
+                            for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                            {
+                                const uint32_t remaining = state / stride[seat] % (capacity[seat] + 1u);
+                                needed += remaining;
+
+                                if (remaining > 0 && (allowed[seat] & (euchre_card_mask(1) << cards[i])))
+                                    count += ways[(i + 1) * num_states + state - stride[seat]];
+                            }
+
+                            // the card may also be left undealt, if there are more cards than seats need
+                            if (needed < cards.size() - i)
+                                count += ways[(i + 1) * num_states + state];
+
+                            ways[i * num_states + state] = count;
+                        }
+                    }
+
+                    feasible = (ways[initial_state()] > 0);
+                }
+
+                // returns true if at least one consistent deal exists
+                bool is_feasible() const
+                {
+                    return feasible;
+                }
+
+                // returns the number of consistent deals
+                uint64_t count() const
+                {
+                    return feasible ? ways[initial_state()] : 0;
+                }
+
+                // deal the unseen cards to the seats. returns false if there is no consistent deal.
+                bool sample(euchre_random_engine &engine, std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> &hands) const
+                {
+                    if (!feasible)
+                        return false;
+
+                    hands = placed;
+                    uint32_t state = initial_state();
+
+                    for (size_t i = 0; i < cards.size(); ++i)
+                    {
+                        const euchre_card_mask bit = euchre_card_mask(1) << cards[i];
+                        const uint64_t *next = &ways[(i + 1) * num_states];
+
+                        std::uniform_int_distribution<uint64_t> dist(0, ways[i * num_states + state] - 1);
+                        uint64_t pick = dist(engine);
+
+                        // if no seat is picked, the card is left undealt
+                        for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                        {
+                            if (state / stride[seat] % (capacity[seat] + 1u) == 0 || !(allowed[seat] & bit))
+                                continue;
+
+                            const uint64_t w = next[state - stride[seat]];
+
+                            if (pick < w)
+                            {
+                                hands[seat] |= bit;
+                                state -= stride[seat];
+                                break;
+                            }
+
+                            pick -= w;
+                        }
+                    }
+
+                    return true;
+                }
+
+            private:
+                // the state where every seat still needs its full capacity
+                uint32_t initial_state() const
+                {
+                    uint32_t state = 0;
+
+                    for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                        state += capacity[seat] * stride[seat];
+
+                    return state;
+                }
+            };
+
+            // deal the unseen cards to the seats, uniformly among the deals consistent with the
+            // constraints. returns false if there is no consistent deal.
+            static bool sample_deal(const deal_constraints &constraints,
+                                    euchre_random_engine &engine,
+                                    std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> &hands)
+            {
+                return deal_sampler(constraints).sample(engine, hands);
+            }
+
+        } // namespace euchre_algo
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
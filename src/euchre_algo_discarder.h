@@ -85,8 +85,9 @@ namespace rda
                 }
             };
 
-            // attempt to discard the weakest card from a hand, when trump_suit is trump
-            static void discarder(euchre_hand &hand, const euchre_card &card_added, const e_suit trump_suit)
+            // attempt to discard the weakest card from a hand, when trump_suit is trump. the
+            // engine breaks ties between suits.
+            static void discarder(euchre_hand &hand, const euchre_card &card_added, const e_suit trump_suit, euchre_random_engine &engine)
             {
                 // sanity check that the hand has the appropriate number of cards
                 if (hand.size() != euchre_constants::EUCHRE_HAND_SIZE + 1)
@@ -154,8 +155,7 @@ namespace rda
                     remaining.push_back(spades);
 
                 // shuffle the order we consider suits
-                seed_randomizer();
-                std::random_shuffle(remaining.begin(), remaining.end());
+                std::shuffle(remaining.begin(), remaining.end(), engine);
 
                 // iterate over remaining containers. find the lowest rank that could short-suit
                 euchre_card lowest_short_suit_card(e_suit::INVALID, e_rank::ACE);
@@ -0,0 +1,218 @@
+#pragma once
+
+//
+// euchre_algo_pimc.h - Perfect information monte carlo (PIMC) card selection
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "euchre_algo_card_sorter.h"
+#include "euchre_algo_deal_sampler.h"
+#include "euchre_algo_solver.h"
+#include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_constants.h"
+#include "random_seeder.h"
+#include "work_stealing_pool.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        namespace euchre_algo
+        {
+            // settings for choosing a card to play by sampling deals
+            struct pimc_settings
+            {
+                // number of deals to sample for each decision (0 to choose cards without sampling)
+                uint32_t num_samples = 0;
+
+                // wall clock time allowed for each decision in milliseconds (0 for no limit). when
+                // time runs out the best card over the samples solved so far is played. a sample
+                // already being solved is not interrupted.
+                uint32_t time_limit_ms = 0;
+
+                // pool to solve samples on (nullptr to solve them on the calling thread)
+                work_stealing_pool *pool = nullptr;
+            };
+
+            // samples of one decision, shared by the threads solving them
+            struct pimc_tally
+            {
+                // the position as seen by the player, and the sampler of deals of the unseen cards
+                solver_position position;
+                deal_sampler sampler;
+
+                // seed for the random engine of each sample
+                uint64_t seed = 0;
+
+                // number of samples to solve, and the time by which to stop (if timed)
+                uint32_t num_samples = 0;
+                bool timed = false;
+                std::chrono::steady_clock::time_point deadline;
+
+                // next sample to be claimed by a thread
+                std::atomic<uint32_t> next_sample{0};
+
+                // set when the decision has been made, so no more samples are started
+                std::atomic<bool> cancelled{false};
+
+                // guards the results below
+                std::mutex mutex;
+                std::condition_variable finished_cv;
+
+                // total tricks taken over all samples, by card index
+                std::array<uint32_t, euchre_constants::NUM_CARDS> totals{};
+
+                // cards evaluated (the legal moves)
+                euchre_card_mask evaluated = euchre_mask::EMPTY;
+
+                // number of samples finished (including those with no consistent deal)
+                uint32_t finished = 0;
+            };
+
+            // sample one deal and solve it, adding the tricks each legal card takes to the tally.
+            // each sample has its own random engine, so the results do not depend on which thread
+            // solves which sample.
+            static void solve_pimc_sample(pimc_tally &tally, const uint32_t sample)
+            {
+                euchre_random_engine engine(tally.seed, sample);
+
+                std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> hands{};
+                std::vector<std::pair<euchre_card, uint8_t>> moves;
+
+                if (tally.sampler.sample(engine, hands))
+                {
+                    const uint8_t seat_index = tally.position.seat_to_play();
+
+                    solver_position pos = tally.position;
+                    for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                        if (seat != seat_index)
+                            pos.hands[seat] = hands[seat];
+
+                    double_dummy_solver solver(pos, seat_index);
+                    moves = solver.evaluate_moves();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(tally.mutex);
+
+                    for (auto &move : moves)
+                    {
+                        const uint8_t index = euchre_mask::card_index(move.first);
+
+                        tally.totals[index] += move.second;
+                        tally.evaluated |= euchre_card_mask(1) << index;
+                    }
+
+                    ++tally.finished;
+                }
+
+                tally.finished_cv.notify_all();
+            }
+
+            // claim and solve samples until none are left, time runs out, or the decision is made
+            static void solve_pimc_samples(pimc_tally &tally)
+            {
+                while (!tally.cancelled)
+                {
+                    if (tally.timed && std::chrono::steady_clock::now() >= tally.deadline)
+                        break;
+
+                    const uint32_t sample = tally.next_sample++;
+                    if (sample >= tally.num_samples)
+                        break;
+
+                    solve_pimc_sample(tally, sample);
+                }
+            }
+
+            // choose a card for the seat to play in "position" (whose own hand is filled in), by
+            // sampling deals of the unseen cards, solving each double dummy, and picking the card
+            // that takes the most tricks on average. ties go to the lowest card. returns an invalid
+            // card if no consistent deal was solved. the engine seeds the samples.
+            static euchre_card choose_card_pimc(const solver_position &position,
+                                                const deal_constraints &constraints,
+                                                const pimc_settings &settings,
+                                                euchre_random_engine &engine = get_random_engine())
+            {
+                // shared with the pool tasks, which may still be queued after the decision is made
+                const auto tally = std::make_shared<pimc_tally>();
+                tally->position = position;
+                tally->sampler = deal_sampler(constraints);
+
+                // cards thought to be held may be wrong (the dealer may have discarded the up card)
+                if (!tally->sampler.is_feasible())
+                {
+                    deal_constraints relaxed = constraints;
+                    relaxed.required.fill(euchre_mask::EMPTY);
+                    tally->sampler = deal_sampler(relaxed);
+                }
+                tally->seed = engine();
+                tally->num_samples = settings.num_samples;
+                tally->timed = (settings.time_limit_ms > 0);
+                tally->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(settings.time_limit_ms);
+
+                // pool workers claim samples alongside the calling thread
+                if (settings.pool != nullptr)
+                    for (size_t i = 1; i < std::min<size_t>(settings.pool->size() + 1, settings.num_samples); ++i)
+                        settings.pool->submit([tally]() { solve_pimc_samples(*tally); });
+
+                solve_pimc_samples(*tally);
+
+                // wait for samples still being solved by the pool, unless time has run out
+                {
+                    std::unique_lock<std::mutex> lock(tally->mutex);
+                    const auto all_finished = [&tally]() { return tally->finished >= tally->num_samples; };
+
+                    if (tally->timed)
+                        tally->finished_cv.wait_until(lock, tally->deadline, all_finished);
+                    else
+                        tally->finished_cv.wait(lock, all_finished);
+                }
+
+                tally->cancelled = true;
+
+                std::lock_guard<std::mutex> lock(tally->mutex);
+
+                euchre_card best;
+                uint32_t best_total = 0;
+
+                // cards from highest to lowest, so the lowest of equal cards wins
+                for (auto &index : CARD_ORDER.card[card_order_row(position.trump_suit)])
+                {
+                    if (!(tally->evaluated & (euchre_card_mask(1) << index)))
+                        continue;
+
+                    if (tally->totals[index] >= best_total)
+                    {
+                        best = euchre_mask::card_from_index(index);
+                        best_total = tally->totals[index];
+                    }
+                }
+
+                return best;
+            }
+
+        } // namespace euchre_algo
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
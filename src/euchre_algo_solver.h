@@ -0,0 +1,370 @@
+#pragma once
+
+//
+// euchre_algo_solver.h - Double dummy solver for the trick playing phase of a hand
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "euchre_algo_card_sorter.h"
+#include "euchre_algo_transposition_table.h"
+#include "euchre_algo_trick.h"
+#include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_card_suit.h"
+#include "euchre_constants.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        namespace euchre_algo
+        {
+            // a fully known position during trick play
+            struct solver_position
+            {
+                // the cards remaining in each player's hand, indexed by seat
+                std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> hands{};
+
+                // the trump suit
+                e_suit trump_suit = e_suit::INVALID;
+
+                // the seat that led the current trick
+                uint8_t leader_index = 0;
+
+                // the seat sitting out (partner of a loner), or INVALID_INDEX
+                uint8_t sitting_out_index = euchre_constants::INVALID_INDEX;
+
+                // number of cards played so far into the current trick
+                uint8_t num_played = 0;
+
+                // card indexes played into the current trick, in play order
+                std::array<uint8_t, euchre_constants::NUM_PLAYERS> played{};
+
+                // returns the number of cards played into each trick
+                uint8_t players_per_trick() const
+                {
+                    return (sitting_out_index < euchre_constants::NUM_PLAYERS) ? euchre_constants::NUM_PLAYERS - 1 : euchre_constants::NUM_PLAYERS;
+                }
+
+                // returns the next seat to play after "seat_index"
+                uint8_t seat_after(const uint8_t seat_index) const
+                {
+                    uint8_t next = (seat_index + 1) % euchre_constants::NUM_PLAYERS;
+
+                    if (next == sitting_out_index)
+                        next = (next + 1) % euchre_constants::NUM_PLAYERS;
+
+                    return next;
+                }
+
+                // returns the seat that played the n-th card of the current trick
+                uint8_t seat_of_play(const uint8_t n) const
+                {
+                    uint8_t seat = leader_index;
+
+                    for (uint8_t i = 0; i < n; ++i)
+                        seat = seat_after(seat);
+
+                    return seat;
+                }
+
+                // returns the seat whose turn it is to play
+                uint8_t seat_to_play() const
+                {
+                    return seat_of_play(num_played);
+                }
+
+                // add a card to the current trick, for the seat whose turn it is
+                void play(const euchre_card &card)
+                {
+                    hands[seat_to_play()] &= ~euchre_mask::card_bit(card);
+                    played[num_played++] = euchre_mask::card_index(card);
+                }
+            };
+
+            // perfect information (double dummy) solver for trick play. finds the number of tricks
+            // a team takes when all four hands are known and both teams play perfectly.
+            class double_dummy_solver
+            {
+            private:
+                // the position being searched (modified and restored during the search)
+                solver_position pos;
+
+                // team (seat index % 2) whose tricks are being counted
+                uint8_t team;
+
+                // card indexes in order from highest to lowest, for move ordering
+                std::array<uint8_t, euchre_constants::NUM_CARDS> order{};
+
+                // legal moves and trick winners for the trump suit
+                const trick_table &tricks;
+
+                // table of positions already searched at the start of a trick
+                transposition_table &table;
+
+                // zobrist hash of the hands, leader, trump, loner's partner and team
+                uint64_t hash = 0;
+
+                // number of positions visited
+                uint64_t nodes = 0;
+
+            public:
+                // constructor. tricks are counted for the team of "seat_index". the transposition
+                // table may be shared by any number of solves (but not by two threads at once).
+                double_dummy_solver(const solver_position &position, const uint8_t seat_index,
+                                    transposition_table &tt = transposition_table::get_thread_table())
+                    : pos(position),
+                      team(seat_index % 2),
+                      tricks(get_trick_table(position.trump_suit)),
+                      table(tt)
+                {
+                    const zobrist_keys &keys = zobrist_keys::get();
+
+                    for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                        for (euchre_card_mask m = pos.hands[seat]; m != 0; m &= m - 1)
+                            hash ^= keys.card[seat][euchre_mask::lowest_index(m)];
+
+                    hash ^= keys.leader[pos.leader_index % euchre_constants::NUM_PLAYERS];
+                    hash ^= keys.sitting_out[std::min<size_t>(pos.sitting_out_index, euchre_constants::NUM_PLAYERS)];
+                    hash ^= keys.trump[static_cast<uint8_t>(pos.trump_suit) % euchre_constants::NUM_SUITS];
+                    hash ^= keys.team[team];
+
+                    // try the strongest cards first, as sorted by the card sorter. the sorted deck
+                    // groups each effective suit together, from highest to lowest.
+                    const uint8_t row = card_order_row(pos.trump_suit);
+
+                    for (uint8_t i = 0; i < euchre_constants::NUM_CARDS; ++i)
+                        order[i] = CARD_ORDER.card[row][i];
+                }
+
+                // return the number of tricks (not yet completed) the team takes with perfect play
+                uint8_t solve()
+                {
+                    return static_cast<uint8_t>(search(-1, euchre_constants::EUCHRE_HAND_SIZE + 1));
+                }
+
+                // return each legal card for the seat to play, with the number of tricks (not yet
+                // completed) the team takes if that card is played and play is perfect afterward
+                std::vector<std::pair<euchre_card, uint8_t>> evaluate_moves()
+                {
+                    std::vector<std::pair<euchre_card, uint8_t>> result;
+
+                    const euchre_card_mask moves = legal_moves();
+
+                    for (auto &index : order)
+                    {
+                        if (!(moves & (euchre_card_mask(1) << index)))
+                            continue;
+
+                        const solver_position saved = pos;
+                        const uint64_t saved_hash = hash;
+                        const uint8_t won = play_and_score(index);
+
+                        const uint8_t value = won + ((remaining_tricks() > 0) ? static_cast<uint8_t>(search(-1, euchre_constants::EUCHRE_HAND_SIZE + 1)) : 0);
+                        pos = saved;
+                        hash = saved_hash;
+
+                        result.push_back({euchre_mask::card_from_index(index), value});
+                    }
+
+                    return result;
+                }
+
+                // return the number of positions visited so far
+                uint64_t get_nodes() const
+                {
+                    return nodes;
+                }
+
+            private:
+                // return the cards the seat to play may legally play
+                euchre_card_mask legal_moves() const
+                {
+                    return euchre_algo::legal_moves(tricks, pos.hands[pos.seat_to_play()], (pos.num_played > 0) ? pos.played[0] : static_cast<uint8_t>(euchre_constants::NUM_CARDS));
+                }
+
+                // return the number of tricks left to play (including the current one)
+                uint8_t remaining_tricks() const
+                {
+                    return euchre_mask::popcount(pos.hands[pos.seat_to_play()]);
+                }
+
+                // return the seat that wins the (complete) current trick
+                uint8_t trick_winner_seat() const
+                {
+                    const auto &power = tricks.power[static_cast<uint8_t>(tricks.effective_suit[pos.played[0]])];
+
+                    uint8_t winner = 0;
+
+                    for (uint8_t i = 1; i < pos.num_played; ++i)
+                        if (power[pos.played[i]] > power[pos.played[winner]])
+                            winner = i;
+
+                    return pos.seat_of_play(winner);
+                }
+
+                // play a card for the seat to play. if that completes the trick, start the next
+                // trick and return 1 if the team won it. otherwise return 0.
+                uint8_t play_and_score(const uint8_t index)
+                {
+                    const zobrist_keys &keys = zobrist_keys::get();
+                    const uint8_t seat = pos.seat_to_play();
+
+                    pos.hands[seat] &= ~(euchre_card_mask(1) << index);
+                    pos.played[pos.num_played++] = index;
+                    hash ^= keys.card[seat][index];
+
+                    if (pos.num_played < pos.players_per_trick())
+                        return 0;
+
+                    const uint8_t winner = trick_winner_seat();
+
+                    hash ^= keys.leader[pos.leader_index] ^ keys.leader[winner];
+                    pos.leader_index = winner;
+                    pos.num_played = 0;
+
+                    return (winner % 2 == team) ? 1 : 0;
+                }
+
+                // alpha-beta search. returns the number of tricks (not yet completed) the team takes.
+                int search(int alpha, int beta)
+                {
+                    ++nodes;
+
+                    const euchre_card_mask moves = legal_moves();
+
+                    if (moves == 0)
+                        return 0;
+
+                    const int remaining = remaining_tricks();
+                    const bool maximizing = (pos.seat_to_play() % 2 == team);
+
+                    // positions at the start of a trick (with more than one trick left) are cached
+                    const bool cached = (pos.num_played == 0 && remaining > 1);
+
+                    if (cached)
+                    {
+                        const transposition_table::entry *e = table.probe(hash);
+
+                        if (e)
+                        {
+                            if (e->lower == e->upper || e->lower >= beta)
+                                return e->lower;
+                            if (e->upper <= alpha)
+                                return e->upper;
+
+                            alpha = std::max<int>(alpha, e->lower);
+                            beta = std::min<int>(beta, e->upper);
+                        }
+                    }
+
+                    const int alpha_searched = alpha;
+                    const int beta_searched = beta;
+
+                    int best = maximizing ? -1 : remaining + 1;
+
+                    // cards still in a hand or in the current trick
+                    euchre_card_mask in_play = 0;
+                    for (auto &h : pos.hands)
+                        in_play |= h;
+                    for (uint8_t i = 0; i < pos.num_played; ++i)
+                        in_play |= euchre_card_mask(1) << pos.played[i];
+
+                    // true if the previous card still in play (of the same suit) was a move just searched
+                    bool previous_was_move = false;
+                    e_suit previous_suit = e_suit::INVALID;
+
+                    for (auto &index : order)
+                    {
+                        const euchre_card_mask bit = euchre_card_mask(1) << index;
+
+                        // cards already played out of the hand don't separate two cards in sequence
+                        if (!(in_play & bit))
+                            continue;
+
+                        if (tricks.effective_suit[index] != previous_suit)
+                        {
+                            previous_suit = tricks.effective_suit[index];
+                            previous_was_move = false;
+                        }
+
+                        if (!(moves & bit))
+                        {
+                            previous_was_move = false;
+                            continue;
+                        }
+
+                        // a card in sequence with one just searched (e.g. K after A, with Q the next
+                        // card in play) takes exactly the same tricks, so skip it
+                        if (previous_was_move)
+                            continue;
+
+                        previous_was_move = true;
+
+                        const solver_position saved = pos;
+                        const uint64_t saved_hash = hash;
+                        const int won = play_and_score(index);
+
+                        // when a trick completes, search the rest with the window shifted by the trick won
+                        int value = won;
+                        if (remaining_tricks() > 0)
+                            value += search(alpha - won, beta - won);
+
+                        pos = saved;
+                        hash = saved_hash;
+
+                        if (maximizing)
+                        {
+                            best = std::max(best, value);
+                            alpha = std::max(alpha, best);
+                        }
+                        else
+                        {
+                            best = std::min(best, value);
+                            beta = std::min(beta, best);
+                        }
+
+                        if (alpha >= beta)
+                            break;
+                    }
+
+                    // a result outside the window is only a bound on the true value
+                    if (cached)
+                    {
+                        const int lower = (best > alpha_searched) ? best : 0;
+                        const int upper = (best < beta_searched) ? best : remaining;
+
+                        table.store(hash, static_cast<uint8_t>(remaining), static_cast<int8_t>(lower), static_cast<int8_t>(upper));
+                    }
+
+                    return best;
+                }
+            };
+
+            // return the number of tricks (not yet completed) the team of "seat_index" takes
+            // from a fully known position, with perfect play by both teams
+            static uint8_t solve_double_dummy(const solver_position &position, const uint8_t seat_index)
+            {
+                double_dummy_solver solver(position, seat_index);
+                return solver.solve();
+            }
+
+        } // namespace euchre_algo
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
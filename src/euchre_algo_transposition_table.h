@@ -0,0 +1,209 @@
+#pragma once
+
+//
+// euchre_algo_transposition_table.h - Transposition table for the double dummy solver
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "platform_defs.h"
+
+#include "euchre_card_suit.h"
+#include "euchre_constants.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        namespace euchre_algo
+        {
+            // zobrist keys used to hash solver positions
+            struct zobrist_keys
+            {
+                // one key for each card in each seat's hand
+                std::array<std::array<uint64_t, euchre_constants::NUM_CARDS>, euchre_constants::NUM_PLAYERS> card{};
+
+                // one key for each seat leading the next trick
+                std::array<uint64_t, euchre_constants::NUM_PLAYERS> leader{};
+
+                // one key for each seat sitting out (the last is for nobody sitting out)
+                std::array<uint64_t, euchre_constants::NUM_PLAYERS + 1> sitting_out{};
+
+                // one key for each trump suit
+                std::array<uint64_t, euchre_constants::NUM_SUITS> trump{};
+
+                // one key for each team whose tricks are counted
+                std::array<uint64_t, 2> team{};
+
+                // return the keys, generated once from a fixed seed so hashes are the same on every run
+                static const zobrist_keys &get()
+                {
+                    static const zobrist_keys keys = generate();
+                    return keys;
+                }
+
+            private:
+                // splitmix64 step
+                static uint64_t next(uint64_t &state)
+                {
+                    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                    return z ^ (z >> 31);
+                }
+
+                static zobrist_keys generate()
+                {
+                    zobrist_keys k;
+                    uint64_t state = 0x6575636872650000ULL;
+
+                    for (auto &seat : k.card)
+                        for (auto &key : seat)
+                            key = next(state);
+                    for (auto &key : k.leader)
+                        key = next(state);
+                    for (auto &key : k.sitting_out)
+                        key = next(state);
+                    for (auto &key : k.trump)
+                        key = next(state);
+                    for (auto &key : k.team)
+                        key = next(state);
+
+                    return k;
+                }
+            };
+
+            // fixed size table of bounds on the tricks still to be taken from positions at the start
+            // of a trick. the hash covers the cards remaining in every hand, the leader, the trump
+            // suit, the loner's partner and the team counted, so the value does not depend on the
+            // tricks already taken and the table can be shared by any number of solves.
+            class transposition_table
+            {
+            public:
+                // a stored position, with lower and upper bounds on the tricks still to be taken
+                struct entry
+                {
+                    uint64_t key = 0;
+                    int8_t lower = 0;
+                    int8_t upper = 0;
+                    uint8_t depth = 0;
+                };
+
+                // entries sharing a cache line
+                static const size_t ENTRIES_PER_BUCKET = 4;
+
+                struct alignas(64) bucket
+                {
+                    std::array<entry, ENTRIES_PER_BUCKET> entries{};
+                };
+
+                // default number of buckets (256 KB)
+                static const size_t DEFAULT_BUCKETS = 4096;
+
+            private:
+                // storage for the buckets, with room to align them to a cache line
+                std::unique_ptr<uint8_t[]> storage;
+
+                // the buckets (aligned inside storage)
+                bucket *buckets = nullptr;
+
+                // number of buckets minus one (the number of buckets is a power of two)
+                size_t mask = 0;
+
+            public:
+                // constructor. the number of buckets is rounded up to a power of two.
+                explicit transposition_table(const size_t num_buckets = DEFAULT_BUCKETS)
+                {
+                    size_t n = 1;
+                    while (n < num_buckets)
+                        n <<= 1;
+
+                    storage.reset(new uint8_t[(n + 1) * sizeof(bucket)]);
+
+                    const uintptr_t address = reinterpret_cast<uintptr_t>(storage.get());
+                    const uintptr_t aligned = (address + alignof(bucket) - 1) & ~static_cast<uintptr_t>(alignof(bucket) - 1);
+
+                    buckets = reinterpret_cast<bucket *>(aligned);
+                    mask = n - 1;
+
+                    clear();
+                }
+
+                transposition_table(const transposition_table &) = delete;
+                transposition_table &operator=(const transposition_table &) = delete;
+
+                // remove all entries
+                void clear()
+                {
+                    for (size_t i = 0; i <= mask; ++i)
+                        new (&buckets[i]) bucket();
+                }
+
+                // return the number of buckets
+                size_t size() const
+                {
+                    return mask + 1;
+                }
+
+                // find the entry for a key. returns nullptr if not stored.
+                const entry *probe(const uint64_t key) const
+                {
+                    const bucket &b = buckets[key & mask];
+
+                    for (auto &e : b.entries)
+                        if (e.key == key && e.depth != 0)
+                            return &e;
+
+                    return nullptr;
+                }
+
+                // store bounds for a key, tightening any bounds already stored for it. otherwise
+                // the entry with the fewest tricks remaining (the cheapest to search again) is replaced.
+                void store(const uint64_t key, const uint8_t depth, const int8_t lower, const int8_t upper)
+                {
+                    bucket &b = buckets[key & mask];
+                    entry *victim = &b.entries[0];
+
+                    for (auto &e : b.entries)
+                    {
+                        if (e.key == key && e.depth != 0)
+                        {
+                            e.lower = std::max(e.lower, lower);
+                            e.upper = std::min(e.upper, upper);
+                            return;
+                        }
+
+                        if (e.depth < victim->depth)
+                            victim = &e;
+                    }
+
+                    victim->key = key;
+                    victim->depth = depth;
+                    victim->lower = lower;
+                    victim->upper = upper;
+                }
+
+                // return the table for the calling thread
+                static transposition_table &get_thread_table()
+                {
+                    thread_local transposition_table table;
+                    return table;
+                }
+            };
+
+        } // namespace euchre_algo
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
@@ -0,0 +1,200 @@
+#pragma once
+
+//
+// euchre_algo_trick.h - Trick engine: legal moves and trick winners from precomputed tables
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <array>
+#include <cstdint>
+
+#include "platform_defs.h"
+
+#include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_card_rank.h"
+#include "euchre_card_suit.h"
+#include "euchre_constants.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        namespace euchre_algo
+        {
+            // tables for playing tricks under one trump suit, indexed by card mask bit index
+            struct trick_table
+            {
+                // the trump suit (INVALID for no trump)
+                e_suit trump_suit = e_suit::INVALID;
+
+                // cards of each effective suit (the left bower is in the trump suit)
+                std::array<euchre_card_mask, euchre_constants::NUM_SUITS> suit_cards{};
+
+                // effective suit of each card
+                std::array<e_suit, euchre_constants::NUM_CARDS> effective_suit{};
+
+                // power of each card in a trick, by the effective suit lead. the highest power
+                // wins the trick. cards that are neither trump nor of the suit lead have power 0.
+                std::array<std::array<uint8_t, euchre_constants::NUM_CARDS>, euchre_constants::NUM_SUITS> power{};
+            };
+
+            // build the trick table for a trump suit (INVALID for no trump)
+            static trick_table make_trick_table(const e_suit trump)
+            {
+                trick_table t;
+                t.trump_suit = trump;
+
+                for (uint8_t index = 0; index < euchre_constants::NUM_CARDS; ++index)
+                {
+                    const euchre_card card = euchre_mask::card_from_index(index);
+                    const bool right_bower = (card.suit() == trump && card.rank() == e_rank::JACK);
+                    const bool left_bower = (card.suit() == euchre_mask::same_color_suit(trump) && card.rank() == e_rank::JACK);
+                    const e_suit suit = left_bower ? trump : card.suit();
+
+                    // 1-6 for the ranks of a plain suit, 17-22 for the ranks of trump, then the bowers
+                    uint8_t strength = static_cast<uint8_t>(card.rank()) - static_cast<uint8_t>(e_rank::BEGIN) + 1;
+                    if (suit == trump)
+                        strength += 16;
+                    if (left_bower)
+                        strength = 23;
+                    if (right_bower)
+                        strength = 24;
+
+                    t.effective_suit[index] = suit;
+                    t.suit_cards[static_cast<uint8_t>(suit)] |= euchre_card_mask(1) << index;
+
+                    // trump beats every other suit, so its strength counts whatever was lead
+                    for (auto lead = e_suit::BEGIN; lead != e_suit::END; ++lead)
+                        t.power[static_cast<uint8_t>(lead)][index] = (suit == trump || suit == lead) ? strength : 0;
+                }
+
+                return t;
+            }
+
+            // return the trick table for a trump suit (INVALID for no trump)
+            static const trick_table &get_trick_table(const e_suit trump)
+            {
+                static const std::array<trick_table, euchre_constants::NUM_SUITS + 1> tables = {
+                    make_trick_table(e_suit::CLUBS),
+                    make_trick_table(e_suit::DIAMONDS),
+                    make_trick_table(e_suit::HEARTS),
+                    make_trick_table(e_suit::SPADES),
+                    make_trick_table(e_suit::INVALID)};
+
+                return tables[(trump < e_suit::END) ? static_cast<uint8_t>(trump) : euchre_constants::NUM_SUITS];
+            }
+
+            // return the cards of "hand" that may be played, after the card with index "lead_index"
+            // was lead (NUM_CARDS if the hand is leading)
+            static euchre_card_mask legal_moves(const trick_table &table, const euchre_card_mask hand, const uint8_t lead_index)
+            {
+                if (lead_index >= euchre_constants::NUM_CARDS)
+                    return hand;
+
+                const euchre_card_mask follow = hand & table.suit_cards[static_cast<uint8_t>(table.effective_suit[lead_index])];
+
+                return follow ? follow : hand;
+            }
+
+            // a trick being played, which keeps track of the winning card as cards are played
+            class euchre_trick
+            {
+            private:
+                // tables for the trump suit
+                const trick_table *table;
+
+                // card indexes played, and the seats that played them, in play order
+                std::array<uint8_t, euchre_constants::NUM_PLAYERS> cards{};
+                std::array<uint8_t, euchre_constants::NUM_PLAYERS> seats{};
+
+                // number of cards played
+                uint8_t count = 0;
+
+                // position (in play order) of the card winning so far
+                uint8_t winner = 0;
+
+            public:
+                // constructor
+                explicit euchre_trick(const e_suit trump)
+                    : table(&get_trick_table(trump))
+                {
+                }
+
+                // start a new trick
+                void clear()
+                {
+                    count = 0;
+                    winner = 0;
+                }
+
+                // return the number of cards played
+                uint8_t size() const
+                {
+                    return count;
+                }
+
+                // return true if no card has been played
+                bool empty() const
+                {
+                    return count == 0;
+                }
+
+                // return the card played at position "n" (in play order)
+                euchre_card card(const uint8_t n) const
+                {
+                    return euchre_mask::card_from_index(cards[n]);
+                }
+
+                // return the effective suit lead (INVALID if no card has been played)
+                e_suit lead_suit() const
+                {
+                    return empty() ? e_suit::INVALID : table->effective_suit[cards[0]];
+                }
+
+                // return the cards of "hand" that may be played into the trick
+                euchre_card_mask legal_moves(const euchre_card_mask hand) const
+                {
+                    return euchre_algo::legal_moves(*table, hand, empty() ? static_cast<uint8_t>(euchre_constants::NUM_CARDS) : cards[0]);
+                }
+
+                // play a card into the trick for a seat
+                void play(const uint8_t seat_index, const euchre_card &card)
+                {
+                    const uint8_t index = euchre_mask::card_index(card);
+
+                    cards[count] = index;
+                    seats[count] = seat_index;
+
+                    const auto &power = table->power[static_cast<uint8_t>(table->effective_suit[cards[0]])];
+
+                    if (power[index] > power[cards[winner]])
+                        winner = count;
+
+                    ++count;
+                }
+
+                // return the position (in play order) of the card winning the trick so far
+                uint8_t winning_position() const
+                {
+                    return winner;
+                }
+
+                // return the seat winning the trick so far
+                uint8_t winning_seat() const
+                {
+                    return seats[winner];
+                }
+            };
+
+        } // namespace euchre_algo
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
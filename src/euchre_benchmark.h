@@ -0,0 +1,312 @@
+#pragma once
+
+//
+// euchre_benchmark.h - Microbenchmarks of the scoring, sorting and dealing hot paths
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "fileio.h"
+#include "json.h"
+
+#include "euchre_algo_card_sorter.h"
+#include "euchre_algo_discarder.h"
+#include "euchre_card.h"
+#include "euchre_constants.h"
+#include "euchre_deck.h"
+#include "euchre_hand.h"
+#include "euchre_perception.h"
+#include "random_seeder.h"
+#include "score_trump_call.h"
+#include "score_trump_call_batch.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        // timing of one benchmark, over several repetitions of the same number of operations
+        struct euchre_benchmark_result
+        {
+            // name of the benchmark
+            std::string name;
+
+            // operations timed in each repetition
+            uint64_t iterations = 0;
+
+            // number of timed repetitions
+            uint32_t repetitions = 0;
+
+            // nanoseconds per operation, over the repetitions
+            double median_ns = 0.0f;
+            double min_ns = 0.0f;
+            double mean_ns = 0.0f;
+            double stddev_ns = 0.0f;
+
+            // return the header line of the csv output
+            static std::string csv_header()
+            {
+                return "name,iterations,repetitions,median_ns,min_ns,mean_ns,stddev_ns";
+            }
+
+            // return the result as one line of csv
+            std::string to_string() const
+            {
+                std::stringstream ss;
+
+                ss << name
+                   << "," << iterations
+                   << "," << repetitions
+                   << "," << median_ns
+                   << "," << min_ns
+                   << "," << mean_ns
+                   << "," << stddev_ns;
+
+                return ss.str();
+            }
+        };
+
+        // how long, and how many times, to run each benchmark
+        struct euchre_benchmark_settings
+        {
+            // number of timed repetitions
+            uint32_t repetitions = 15;
+
+            // minimum wall clock time of one repetition. the number of operations per
+            // repetition is doubled until one repetition takes at least this long.
+            uint32_t min_repetition_ms = 20;
+        };
+
+        // values returned by the benchmarked operations are folded in here, so the compiler
+        // cannot remove the work that produced them
+        static volatile uint64_t benchmark_sink = 0;
+
+        // time "iterations" calls of op(i), and return the seconds taken
+        template <typename op_type>
+        static double time_benchmark(op_type &op, const uint64_t iterations)
+        {
+            uint64_t sink = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+
+            for (uint64_t i = 0; i < iterations; ++i)
+                sink += op(i);
+
+            const auto stop = std::chrono::steady_clock::now();
+
+            benchmark_sink = benchmark_sink + sink;
+
+            return std::chrono::duration<double>(stop - start).count();
+        }
+
+        // run one benchmark. op(i) performs operation i and returns a value derived from its
+        // result.
+        template <typename op_type>
+        static euchre_benchmark_result run_benchmark(const std::string &name,
+                                                     op_type op,
+                                                     const euchre_benchmark_settings &settings)
+        {
+            euchre_benchmark_result result;
+            result.name = name;
+            result.repetitions = std::max<uint32_t>(settings.repetitions, 1);
+
+            // find the number of operations per repetition (this also warms the caches)
+            const double min_seconds = settings.min_repetition_ms / 1000.0f;
+
+            result.iterations = 1;
+            while (time_benchmark(op, result.iterations) < min_seconds && result.iterations < (uint64_t(1) << 40))
+                result.iterations *= 2;
+
+            std::vector<double> ns(result.repetitions);
+
+            for (auto &t : ns)
+                t = time_benchmark(op, result.iterations) * 1e9 / result.iterations;
+
+            std::sort(ns.begin(), ns.end());
+
+            result.min_ns = ns.front();
+            result.median_ns = (ns.size() % 2 == 1) ? ns[ns.size() / 2] : (ns[ns.size() / 2 - 1] + ns[ns.size() / 2]) / 2.0f;
+
+            for (auto t : ns)
+                result.mean_ns += t;
+            result.mean_ns /= ns.size();
+
+            for (auto t : ns)
+                result.stddev_ns += (t - result.mean_ns) * (t - result.mean_ns);
+            result.stddev_ns = (ns.size() > 1) ? std::sqrt(result.stddev_ns / (ns.size() - 1)) : 0.0f;
+
+            return result;
+        }
+
+        // random inputs shared by the benchmarks. a power of two, so operation i can use input
+        // (i & (NUM_BENCHMARK_INPUTS - 1)).
+        const uint32_t NUM_BENCHMARK_INPUTS = 1024;
+
+        // one random deal: a hand of six cards (the last one picked up) and the up card
+        struct euchre_benchmark_input
+        {
+            std::vector<euchre_card> cards;
+            euchre_hand hand;
+            euchre_hand hand_with_pickup;
+            euchre_card up_card;
+            e_suit trump_suit = e_suit::INVALID;
+        };
+
+        // make the random inputs, the same for every run
+        static std::vector<euchre_benchmark_input> make_benchmark_inputs()
+        {
+            std::vector<euchre_benchmark_input> inputs(NUM_BENCHMARK_INPUTS);
+            euchre_random_engine engine(1);
+            euchre_deck deck;
+
+            for (auto &input : inputs)
+            {
+                deck.init();
+                deck.shuffle(engine);
+
+                for (uint8_t i = 0; i < euchre_constants::EUCHRE_HAND_SIZE; ++i)
+                    input.cards.push_back(deck.draw());
+
+                input.up_card = deck.draw();
+                input.trump_suit = input.up_card.suit();
+                input.hand.add_cards(input.cards);
+                input.hand_with_pickup = input.hand;
+                input.hand_with_pickup.add_card(input.up_card);
+            }
+
+            return inputs;
+        }
+
+        // run every benchmark, and return their results in order
+        static std::vector<euchre_benchmark_result> run_benchmark_suite(const euchre_benchmark_settings &settings = euchre_benchmark_settings())
+        {
+            std::vector<euchre_benchmark_result> results;
+
+            const std::vector<euchre_benchmark_input> inputs = make_benchmark_inputs();
+            const uint32_t input_mask = NUM_BENCHMARK_INPUTS - 1;
+
+            const euchre_perception left(1), partner(2), right(3);
+
+            // score one suit of one hand, computing every term
+            const auto score = [&](const uint64_t i) -> uint64_t {
+                const euchre_benchmark_input &input = inputs[i & input_mask];
+                const e_suit suit = static_cast<e_suit>(i % euchre_constants::NUM_SUITS);
+
+                const auto ctx = score_trump_call::score(suit, input.hand, input.up_card, false, euchre_seat_position::INVALID, left, partner, right);
+                return static_cast<uint64_t>(static_cast<int64_t>(ctx.get_total_score() * 1000.0f));
+            };
+
+            score_trump_call_table::set_current(nullptr);
+            results.push_back(run_benchmark("score_trump_call::score", score, settings));
+
+            // the same, reading the hand terms from the precomputed table
+            score_trump_call::enable_table();
+            results.push_back(run_benchmark("score_trump_call::score(table)", score, settings));
+            score_trump_call_table::set_current(nullptr);
+
+            // score all four suits of one hand, one suit at a time and then in one pass
+            const auto weights_ptr = score_trump_call_weights::current();
+            results.push_back(run_benchmark("score_trump_call::score(x4)", [&](const uint64_t i) -> uint64_t {
+                const euchre_benchmark_input &input = inputs[i & input_mask];
+
+                double total = 0.0f;
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                    total += score_trump_call::score(weights_ptr, s, input.hand, input.up_card, false, euchre_seat_position::INVALID, left, partner, right).get_total_score();
+
+                return static_cast<uint64_t>(static_cast<int64_t>(total * 1000.0f));
+            },
+                                             settings));
+
+            results.push_back(run_benchmark("score_trump_call::score_suits", [&](const uint64_t i) -> uint64_t {
+                const euchre_benchmark_input &input = inputs[i & input_mask];
+
+                const auto scores = score_trump_call::score_suits(weights_ptr, input.hand, input.up_card, false, euchre_seat_position::INVALID, left, partner, right);
+                return static_cast<uint64_t>(static_cast<int64_t>((scores[0] + scores[1] + scores[2] + scores[3]) * 1000.0f));
+            },
+                                             settings));
+
+            // score the hand terms of every input hand, for all four suits, in one batch
+            score_trump_call_batch batch;
+            for (auto &input : inputs)
+                batch.add(input.hand.mask());
+
+            const score_trump_call_weights weights = *score_trump_call_weights::current();
+            results.push_back(run_benchmark("score_trump_call_batch::score(1024x4)", [&](const uint64_t i) -> uint64_t {
+                batch.score(weights);
+                return static_cast<uint64_t>(static_cast<int64_t>(batch.get(i & input_mask, e_suit::CLUBS)));
+            },
+                                             settings));
+
+            // discard down to five cards after picking up the up card
+            euchre_random_engine engine(2);
+            results.push_back(run_benchmark("euchre_algo::discarder", [&](const uint64_t i) -> uint64_t {
+                const euchre_benchmark_input &input = inputs[i & input_mask];
+
+                euchre_hand hand = input.hand_with_pickup;
+                euchre_algo::discarder(hand, input.up_card, input.trump_suit, engine);
+                return hand.mask();
+            },
+                                             settings));
+
+            // sort a hand by suit
+            std::vector<euchre_card> cards;
+            results.push_back(run_benchmark("euchre_algo::sort_deck_by_suit", [&](const uint64_t i) -> uint64_t {
+                const euchre_benchmark_input &input = inputs[i & input_mask];
+
+                cards.assign(input.cards.cbegin(), input.cards.cend());
+                euchre_algo::sort_deck_by_suit(cards, input.trump_suit);
+                return cards.front().id();
+            },
+                                             settings));
+
+            // parse the weights file
+            rda::fileio f("euchre.json");
+            if (f.read())
+            {
+                const std::string text = f.to_string();
+
+                results.push_back(run_benchmark("json::parse", [&](const uint64_t) -> uint64_t {
+                    return rda::json::parse(text) != nullptr;
+                },
+                                                 settings));
+            }
+
+            // shuffle a deck and deal four hands
+            euchre_deck deck;
+            euchre_hand hands[euchre_constants::NUM_PLAYERS];
+            results.push_back(run_benchmark("euchre_deck::shuffle+deal", [&](const uint64_t) -> uint64_t {
+                deck.init();
+                deck.shuffle(engine);
+
+                uint64_t m = 0;
+                for (auto &hand : hands)
+                {
+                    hand.clear();
+                    deck.deal(hand, euchre_constants::EUCHRE_HAND_SIZE);
+                    m ^= hand.mask();
+                }
+
+                return m;
+            },
+                                             settings));
+
+            return results;
+        }
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
@@ -7,81 +7,156 @@
 //
 
 #include <cstdint>
-#include <sstream>
 #include <string>
 
 #include "euchre_card_color.h"
 #include "euchre_card_rank.h"
 #include "euchre_card_suit.h"
+#include "euchre_constants.h"
 
 namespace rda
 {
     namespace euchre
     {
+        // card ids. a card is stored as one byte, (suit * 6) + (rank - NINE), which is also its
+        // bit index in a euchre_card_mask. id NUM_CARDS is the invalid card.
+        namespace euchre_card_id
+        {
+            // id of the invalid card
+            const uint8_t INVALID = euchre_constants::NUM_CARDS;
+
+            // returns the id of a card, or INVALID if the suit or rank is invalid
+            constexpr uint8_t make(const e_suit s, const e_rank r)
+            {
+                return (s >= e_suit::END || r < e_rank::BEGIN || r >= e_rank::END)
+                           ? INVALID
+                           : static_cast<uint8_t>(static_cast<uint8_t>(s) * euchre_constants::NUM_RANKS +
+                                                  (static_cast<uint8_t>(r) - static_cast<uint8_t>(e_rank::BEGIN)));
+            }
+
+            // suit, rank and color of every card id (and the invalid card)
+            struct decode_table
+            {
+                e_suit suit[euchre_constants::NUM_CARDS + 1];
+                e_rank rank[euchre_constants::NUM_CARDS + 1];
+                e_color color[euchre_constants::NUM_CARDS + 1];
+            };
+
+            // build the decode table
+            constexpr decode_table make_decode_table()
+            {
+                decode_table t{};
+
+                for (uint8_t id = 0; id < euchre_constants::NUM_CARDS; ++id)
+                {
+                    const uint8_t suit = id / euchre_constants::NUM_RANKS;
+
+                    t.suit[id] = static_cast<e_suit>(suit);
+                    t.rank[id] = static_cast<e_rank>(static_cast<uint8_t>(e_rank::BEGIN) + id % euchre_constants::NUM_RANKS);
+                    t.color[id] = (suit == static_cast<uint8_t>(e_suit::CLUBS) || suit == static_cast<uint8_t>(e_suit::SPADES)) ? e_color::BLACK : e_color::RED;
+                }
+
+                t.suit[INVALID] = e_suit::INVALID;
+                t.rank[INVALID] = e_rank::INVALID;
+                t.color[INVALID] = e_color::INVALID;
+
+                return t;
+            }
+
+            // the decode table, computed at compile time
+            constexpr decode_table DECODE = make_decode_table();
+
+            // printable name of every card id (and the invalid card)
+            const char *const NAMES[euchre_constants::NUM_CARDS + 1] = {
+                "[9C]", "[10C]", "[JC]", "[QC]", "[KC]", "[AC]",
+                "[9D]", "[10D]", "[JD]", "[QD]", "[KD]", "[AD]",
+                "[9H]", "[10H]", "[JH]", "[QH]", "[KH]", "[AH]",
+                "[9S]", "[10S]", "[JS]", "[QS]", "[KS]", "[AS]",
+                "[XX]"};
+
+            static_assert(make(e_suit::HEARTS, e_rank::JACK) == 14, "card ids are suit major");
+            static_assert(DECODE.color[make(e_suit::SPADES, e_rank::ACE)] == e_color::BLACK, "spades are black");
+
+        } // namespace euchre_card_id
+
         // playing card in a euchre deck
         class euchre_card
         {
         public:
             // default constructor
-            euchre_card()
-                : m_suit(e_suit::INVALID), m_rank(e_rank::INVALID)
+            constexpr euchre_card()
+                : m_id(euchre_card_id::INVALID)
             {
             }
 
             // initializing constructor
-            euchre_card(const e_suit s, const e_rank r)
-                : m_suit(s), m_rank(r)
+            constexpr euchre_card(const e_suit s, const e_rank r)
+                : m_id(euchre_card_id::make(s, r))
+            {
+            }
+
+            // returns the card for an id (0-23), or an invalid card
+            static constexpr euchre_card from_id(const uint8_t id)
+            {
+                return euchre_card(id);
+            }
+
+            // returns the card id (0-23), or euchre_card_id::INVALID
+            constexpr uint8_t id() const
             {
+                return m_id;
             }
 
             // returns the card color
-            e_color color() const
+            constexpr e_color color() const
             {
-                if (m_suit == e_suit::INVALID)
-                    return e_color::INVALID;
-                if (m_suit == e_suit::CLUBS || m_suit == e_suit::SPADES)
-                    return e_color::BLACK;
-                return e_color::RED;
+                return euchre_card_id::DECODE.color[m_id];
             }
 
             // returns the card suit
-            e_suit suit() const
+            constexpr e_suit suit() const
             {
-                return m_suit;
+                return euchre_card_id::DECODE.suit[m_id];
             }
 
             // returns the card rank
-            e_rank rank() const
+            constexpr e_rank rank() const
             {
-                return m_rank;
+                return euchre_card_id::DECODE.rank[m_id];
             }
 
             // returns true if the cards are equal
-            bool operator==(const euchre_card &rhs) const
+            constexpr bool operator==(const euchre_card &rhs) const
             {
-                return (m_rank == rhs.m_rank) && (m_suit == rhs.m_suit);
+                return m_id == rhs.m_id;
+            }
+
+            // returns the printable name of the card, without allocating
+            const char *name() const
+            {
+                return euchre_card_id::NAMES[m_id];
             }
 
             // returns string representation of the card
             std::string to_string() const
             {
-                std::stringstream ss;
-
-                ss << "[" << rda::euchre::to_string(m_rank)
-                   << rda::euchre::to_string(m_suit) << "]";
-
-                return ss.str();
+                return name();
             }
 
         private:
-            // the card suit
-            e_suit m_suit;
+            // construct from an id, mapping out of range ids to the invalid card
+            constexpr explicit euchre_card(const uint8_t id)
+                : m_id((id < euchre_constants::NUM_CARDS) ? id : euchre_card_id::INVALID)
+            {
+            }
 
-            // the card rank
-            e_rank m_rank;
+            // the card id
+            uint8_t m_id;
 
         }; // class euchre_card
 
+        static_assert(sizeof(euchre_card) == 1, "a card is one byte");
+
     } // namespace euchre
 
 } // namespace rda
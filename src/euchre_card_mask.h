@@ -0,0 +1,211 @@
+#pragma once
+
+//
+// euchre_card_mask.h - Bitmask representation of a set of euchre cards
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "platform_defs.h"
+
+#include "euchre_card.h"
+#include "euchre_card_rank.h"
+#include "euchre_card_suit.h"
+#include "euchre_constants.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        // set of cards, with one bit for each of the 24 cards in a euchre deck.
+        // bit index is (suit * 6) + (rank - NINE), so each suit occupies 6 consecutive bits.
+        typedef uint32_t euchre_card_mask;
+
+        namespace euchre_mask
+        {
+            // mask with no cards
+            const euchre_card_mask EMPTY = 0x000000;
+
+            // mask with every card in the deck
+            const euchre_card_mask FULL_DECK = 0xFFFFFF;
+
+            // mask of the six cards of the lowest suit (clubs)
+            const euchre_card_mask SUIT_BITS = 0x3F;
+
+            // returns the bit index (0-23) of a card, or NUM_CARDS for an invalid card
+            static uint8_t card_index(const euchre_card &card)
+            {
+                return card.id();
+            }
+
+            // returns the card for a bit index (0-23)
+            static euchre_card card_from_index(const uint8_t index)
+            {
+                return euchre_card::from_id(index);
+            }
+
+            // returns the mask for a single card (empty for an invalid card)
+            static euchre_card_mask card_bit(const euchre_card &card)
+            {
+                const uint8_t index = card_index(card);
+
+                if (index >= euchre_constants::NUM_CARDS)
+                    return EMPTY;
+
+                return euchre_card_mask(1) << index;
+            }
+
+            // returns the mask of a single suit (ignoring bowers)
+            static euchre_card_mask suit_mask(const e_suit suit)
+            {
+                if (suit >= e_suit::END)
+                    return EMPTY;
+
+                return SUIT_BITS << (static_cast<uint8_t>(suit) * euchre_constants::NUM_RANKS);
+            }
+
+            // returns the mask of all four cards of a given rank
+            static euchre_card_mask rank_mask(const e_rank rank)
+            {
+                euchre_card_mask m = EMPTY;
+
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                    m |= card_bit(euchre_card(s, rank));
+
+                return m;
+            }
+
+            // returns the suit of the same color as the given suit
+            static e_suit same_color_suit(const e_suit suit)
+            {
+                switch (suit)
+                {
+                    case e_suit::CLUBS:
+                        return e_suit::SPADES;
+                    case e_suit::DIAMONDS:
+                        return e_suit::HEARTS;
+                    case e_suit::HEARTS:
+                        return e_suit::DIAMONDS;
+                    case e_suit::SPADES:
+                        return e_suit::CLUBS;
+                    default:
+                        return e_suit::INVALID;
+                }
+            }
+
+            // returns the mask of the right bower for a trump suit
+            static euchre_card_mask right_bower_mask(const e_suit trump)
+            {
+                return card_bit(euchre_card(trump, e_rank::JACK));
+            }
+
+            // returns the mask of the left bower for a trump suit
+            static euchre_card_mask left_bower_mask(const e_suit trump)
+            {
+                return card_bit(euchre_card(same_color_suit(trump), e_rank::JACK));
+            }
+
+            // returns the mask of both bowers for a trump suit
+            static euchre_card_mask bowers_mask(const e_suit trump)
+            {
+                return right_bower_mask(trump) | left_bower_mask(trump);
+            }
+
+            // returns the mask of all seven trump cards (including the left bower)
+            static euchre_card_mask trump_mask(const e_suit trump)
+            {
+                return suit_mask(trump) | left_bower_mask(trump);
+            }
+
+            // returns the mask of cards whose effective suit is "suit", when "trump" is trump
+            static euchre_card_mask effective_suit_mask(const e_suit suit, const e_suit trump)
+            {
+                if (suit == trump)
+                    return trump_mask(trump);
+
+                return suit_mask(suit) & ~left_bower_mask(trump);
+            }
+
+            // returns true if all cards in "cards" are also in "mask"
+            static bool contains_all(const euchre_card_mask mask, const euchre_card_mask cards)
+            {
+                return (mask & cards) == cards;
+            }
+
+            // returns the number of cards in the mask
+            static uint8_t popcount(const euchre_card_mask mask)
+            {
+#if defined(__GNUG__) || defined(__clang__)
+                return static_cast<uint8_t>(__builtin_popcount(mask));
+#elif defined(_MSC_VER)
+                return static_cast<uint8_t>(__popcnt(mask));
+#else
+                uint8_t count = 0;
+                for (euchre_card_mask m = mask; m != 0; m &= m - 1)
+                    ++count;
+                return count;
+#endif
+            }
+
+            // returns the bit index of the lowest card in a non-empty mask
+            static uint8_t lowest_index(const euchre_card_mask mask)
+            {
+#if defined(__GNUG__) || defined(__clang__)
+                return static_cast<uint8_t>(__builtin_ctz(mask));
+#elif defined(_MSC_VER)
+                unsigned long index = 0;
+                _BitScanForward(&index, mask);
+                return static_cast<uint8_t>(index);
+#else
+                uint8_t index = 0;
+                while (((mask >> index) & 1) == 0)
+                    ++index;
+                return index;
+#endif
+            }
+
+            // returns the bit index of the highest card in a non-empty mask
+            static uint8_t highest_index(const euchre_card_mask mask)
+            {
+#if defined(__GNUG__) || defined(__clang__)
+                return static_cast<uint8_t>(31 - __builtin_clz(mask));
+#elif defined(_MSC_VER)
+                unsigned long index = 0;
+                _BitScanReverse(&index, mask);
+                return static_cast<uint8_t>(index);
+#else
+                uint8_t index = 31;
+                while (((mask >> index) & 1) == 0)
+                    --index;
+                return index;
+#endif
+            }
+
+            // returns the number of suits (by printed suit) present in the mask
+            static uint8_t count_suits(const euchre_card_mask mask)
+            {
+                uint8_t count = 0;
+
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                    if (mask & suit_mask(s))
+                        ++count;
+
+                return count;
+            }
+
+        } // namespace euchre_mask
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
@@ -7,6 +7,12 @@
 //
 
 #include <cstdint>
+#include <string>
+
+#include "platform_defs.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
 
 namespace rda
 {
@@ -79,3 +85,5 @@ namespace rda
     } // namespace euchre
 
 } // namespace rda
+
+POP_WARN_DISABLE
@@ -21,6 +21,14 @@ namespace rda
 
             const static uint8_t EUCHRE_HAND_SIZE = 5;
 
+            const static uint8_t MAX_HAND_SIZE = EUCHRE_HAND_SIZE + 1;
+
+            const static uint8_t NUM_SUITS = 4;
+
+            const static uint8_t NUM_RANKS = 6;
+
+            const static uint8_t NUM_CARDS = NUM_SUITS * NUM_RANKS;
+
         }; // class euchre_constants
 
     } // namespace euchre
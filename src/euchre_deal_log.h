@@ -0,0 +1,181 @@
+#pragma once
+
+//
+// euchre_deal_log.h - Record and replay euchre deals, in a compact binary file
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fileio.h"
+
+#include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_constants.h"
+
+namespace rda
+{
+    namespace euchre
+    {
+        // the cards of one deal, before anyone picks up or discards
+        struct euchre_deal
+        {
+            // seat index of the dealer
+            uint8_t dealer_index = euchre_constants::INVALID_INDEX;
+
+            // the card turned up for trump
+            euchre_card up_card;
+
+            // the five cards dealt to each seat
+            std::array<std::array<euchre_card, euchre_constants::EUCHRE_HAND_SIZE>, euchre_constants::NUM_PLAYERS> hands{};
+        };
+
+        // a list of deals, saved to a binary file as a header and then one 22 byte record per
+        // deal: the dealer index, the up card, and the 20 cards dealt in seat order. each card is
+        // one byte (its card mask bit index).
+        class euchre_deal_log
+        {
+        public:
+            // bytes in the record of one deal
+            static const size_t RECORD_SIZE = 2 + euchre_constants::NUM_PLAYERS * euchre_constants::EUCHRE_HAND_SIZE;
+
+            // identifies a deal file ("EUCHDEAL")
+            static const uint64_t FILE_MAGIC = 0x4C41454448435545ULL;
+
+            typedef std::array<uint8_t, RECORD_SIZE> record;
+
+        private:
+            // the deals, as records
+            std::vector<record> records;
+
+        public:
+            // return the number of deals
+            size_t size() const
+            {
+                return records.size();
+            }
+
+            // return true if there are no deals
+            bool empty() const
+            {
+                return records.empty();
+            }
+
+            // remove all deals
+            void clear()
+            {
+                records.clear();
+            }
+
+            // add a deal to the end of the log
+            void add(const euchre_deal &deal)
+            {
+                record r{};
+                size_t n = 0;
+
+                r[n++] = deal.dealer_index;
+                r[n++] = euchre_mask::card_index(deal.up_card);
+
+                for (auto &hand : deal.hands)
+                    for (auto &card : hand)
+                        r[n++] = euchre_mask::card_index(card);
+
+                records.push_back(r);
+            }
+
+            // return deal number "index"
+            euchre_deal get(const size_t index) const
+            {
+                const record &r = records[index];
+                euchre_deal deal;
+                size_t n = 0;
+
+                deal.dealer_index = r[n++];
+                deal.up_card = euchre_mask::card_from_index(r[n++]);
+
+                for (auto &hand : deal.hands)
+                    for (auto &card : hand)
+                        card = euchre_mask::card_from_index(r[n++]);
+
+                return deal;
+            }
+
+            // write the deals to a binary file
+            bool save(const std::string &path) const
+            {
+                rda::fileio f(path);
+
+                const uint64_t magic = FILE_MAGIC;
+                const uint64_t count = records.size();
+
+                // size the buffer once, rather than growing it for every record
+                if (!f.resize(sizeof(magic) + sizeof(count) + records.size() * RECORD_SIZE))
+                    return false;
+
+                size_t pos = 0;
+                bool ok = f.put_raw(pos, magic);
+                pos += sizeof(magic);
+
+                ok = ok && f.put_raw(pos, count);
+                pos += sizeof(count);
+
+                for (auto &r : records)
+                {
+                    ok = ok && f.put_raw(pos, r);
+                    pos += RECORD_SIZE;
+                }
+
+                return ok && f.write();
+            }
+
+            // read deals from a binary file, replacing any deals in the log. returns false (and
+            // leaves the log empty) if the file is missing or corrupt.
+            bool load(const std::string &path)
+            {
+                records.clear();
+
+                rda::fileio f(path);
+                if (!f.read())
+                    return false;
+
+                size_t pos = 0;
+                uint64_t magic = 0;
+                uint64_t count = 0;
+
+                if (!f.get_raw(pos, magic) || magic != FILE_MAGIC)
+                    return false;
+                pos += sizeof(magic);
+
+                if (!f.get_raw(pos, count) || f.size() != pos + sizeof(count) + count * RECORD_SIZE)
+                    return false;
+                pos += sizeof(count);
+
+                records.resize(count);
+
+                for (auto &r : records)
+                {
+                    f.get_raw(pos, r);
+                    pos += RECORD_SIZE;
+
+                    // reject bad dealer indexes and card ids
+                    if (r[0] >= euchre_constants::NUM_PLAYERS ||
+                        std::any_of(r.cbegin() + 1, r.cend(), [](const uint8_t c) { return c >= euchre_constants::NUM_CARDS; }))
+                    {
+                        records.clear();
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+        }; // class euchre_deal_log
+
+    } // namespace euchre
+
+} // namespace rda
@@ -7,13 +7,14 @@
 //
 
 #include <algorithm>
-#include <cstdlib>
-#include <random>
+#include <array>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "euchre_card.h"
+#include "euchre_constants.h"
 #include "euchre_hand.h"
 #include "random_seeder.h"
 
@@ -21,15 +22,22 @@ namespace rda
 {
     namespace euchre
     {
-        // euchre deck of cards
+        // euchre deck of cards. the cards are kept in a fixed array, and drawing moves a cursor
+        // past the top card, so shuffling and dealing never allocate.
         class euchre_deck
         {
         private:
-            // cards in the deck
-            std::vector<euchre_card> cards;
+            // cards in the deck. cards[top] is the top card, and cards before it have been drawn.
+            std::array<euchre_card, euchre_constants::NUM_CARDS> cards{};
+
+            // index of the top card
+            uint8_t top = euchre_constants::NUM_CARDS;
 
             // discarded cards
-            std::vector<euchre_card> discard_pile;
+            std::array<euchre_card, euchre_constants::NUM_CARDS> discard_pile{};
+
+            // number of discarded cards
+            uint8_t num_discarded = 0;
 
         public:
             // default constructor
@@ -40,67 +48,60 @@ namespace rda
             // initialize cards in a euchre deck
             void init()
             {
-                cards.clear();
-                discard_pile.clear();
+                static const std::array<euchre_card, euchre_constants::NUM_CARDS> FULL_DECK = make_full_deck();
 
-                for (auto s = rda::euchre::e_suit::BEGIN; s != e_suit::END; ++s)
-                    for (auto r = e_rank::BEGIN; r != e_rank::END; ++r)
-                        cards.push_back(euchre_card(s, r));
+                cards = FULL_DECK;
+                top = 0;
+                num_discarded = 0;
             }
 
-            // shuffle the deck
-            void shuffle()
+            // shuffle the cards remaining in the deck
+            void shuffle(euchre_random_engine &engine)
             {
-                rda::euchre::seed_randomizer();
-                std::random_shuffle(cards.begin(), cards.end());
+                std::shuffle(cards.begin() + top, cards.end(), engine);
             }
 
             // deal n cards out of the deck and into hand
             void deal(euchre_hand &hand, const size_t n)
             {
-                if (n <= cards.size())
-                {
-                    hand.add_cards(std::vector<euchre_card>(cards.cbegin(), cards.cbegin() + n));
-                    cards.erase(cards.begin(), cards.begin() + n);
-                }
+                if (n <= size())
+                    for (size_t i = 0; i < n; ++i)
+                        hand.add_card(cards[top++]);
             }
 
             // draw one card from top of the deck
             euchre_card draw()
             {
-                euchre_card c;
+                if (empty())
+                    return euchre_card();
 
-                if (!cards.empty())
-                {
-                    c = cards[0];
-                    cards.erase(cards.begin(), cards.begin() + 1);
-                }
-
-                return c;
+                return cards[top++];
             }
 
             // put cards into the discard pile
             void discard(const std::vector<euchre_card> &d)
             {
-                std::copy(d.cbegin(), d.cend(), discard_pile.end());
+                for (auto &c : d)
+                    if (num_discarded < discard_pile.size())
+                        discard_pile[num_discarded++] = c;
             }
 
             // return the number of cards in the deck
             size_t size() const
             {
-                return cards.size();
+                return cards.size() - top;
             }
 
             // return the number of discarded cards
             size_t size_discard() const
             {
-                return discard_pile.size();
+                return num_discarded;
             }
 
             // return true if the deck is empty
-            size_t empty() const
+            bool empty() const
             {
-                return cards.empty();
+                return top >= cards.size();
             }
 
             // return a string representation of the deck
@@ -109,19 +110,33 @@ namespace rda
                 std::stringstream ss;
 
                 ss << "cards:  ";
-                for (auto &c : cards)
-                    ss << " " << c.to_string();
+                for (size_t i = top; i < cards.size(); ++i)
+                    ss << " " << cards[i].name();
                 ss << std::endl;
 
                 ss << "discard:";
-                for (auto &d : discard_pile)
-                    ss << " " << d.to_string();
+                for (size_t i = 0; i < num_discarded; ++i)
+                    ss << " " << discard_pile[i].name();
 
                 ss << std::endl;
 
                 return ss.str();
             }
 
+        private:
+            // returns every card, ordered by suit and then rank
+            static std::array<euchre_card, euchre_constants::NUM_CARDS> make_full_deck()
+            {
+                std::array<euchre_card, euchre_constants::NUM_CARDS> deck{};
+                size_t i = 0;
+
+                for (auto s = rda::euchre::e_suit::BEGIN; s != e_suit::END; ++s)
+                    for (auto r = e_rank::BEGIN; r != e_rank::END; ++r)
+                        deck[i++] = euchre_card(s, r);
+
+                return deck;
+            }
+
         }; // class euchre_deck
 
     } // namespace euchre
@@ -12,22 +12,33 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <vector>
 
+#include "euchre_algo_card_sorter.h"
+#include "euchre_algo_pimc.h"
+#include "euchre_algo_trick.h"
 #include "euchre_card.h"
 #include "euchre_constants.h"
+#include "euchre_deal_log.h"
 #include "euchre_deck.h"
 #include "euchre_hand.h"
 #include "euchre_player_computer.h"
 #include "euchre_player_human.h"
 #include "euchre_scoreboard.h"
 #include "euchre_trump_decision.h"
+#include "random_seeder.h"
+#include "score_trump_call_weights.h"
 
 namespace rda
 {
     namespace euchre
     {
-        // the euchre game
-        class euchre_game
+        // the euchre game, with the player type of each seat fixed at compile time. decisions are
+        // called on the concrete player types, so a game of final player types pays no virtual
+        // calls or heap indirection.
+        template <typename player0_type, typename player1_type, typename player2_type, typename player3_type>
+        class basic_euchre_game
         {
         private:
             // the card that is turned up for trump calling
@@ -51,21 +62,44 @@ namespace rda
             // the scoreboard
             euchre_scoreboard scoreboard;
 
-            // vector of the players
-            std::vector<std::unique_ptr<euchre_player>> players;
+            // the players, by seat
+            std::tuple<player0_type, player1_type, player2_type, player3_type> players;
+
+            // true if the game should not write anything to stdout
+            bool headless = false;
+
+            // number of hands played (including hands where nobody called trump)
+            uint32_t hands_played = 0;
+
+            // random engine for shuffling
+            euchre_random_engine random_engine;
+
+            // log that each deal is added to (nullptr to not record deals)
+            euchre_deal_log *deal_recorder = nullptr;
+
+            // log of deals to play instead of shuffling (nullptr to shuffle), and the next deal
+            const euchre_deal_log *deal_source = nullptr;
+            size_t next_deal = 0;
 
         public:
-            // constructor
-            euchre_game()
+            // constructor. the same seed plays the same game.
+            basic_euchre_game(const bool headless_ = false, const uint64_t seed_value = make_random_seed())
+                : players(player0_type(0), player1_type(1), player2_type(2), player3_type(3)),
+                  headless(headless_)
             {
-                players.push_back(std::make_unique<euchre_player>(euchre_player_human(0)));
-                players.push_back(std::make_unique<euchre_player>(euchre_player_computer(1)));
-                players.push_back(std::make_unique<euchre_player>(euchre_player_computer(2)));
-                players.push_back(std::make_unique<euchre_player>(euchre_player_computer(3)));
 
+                seed(seed_value);
                 init_game();
             }
 
+            // seed the game's random engine, and give each player its own stream split from it
+            void seed(const uint64_t seed_value, const uint64_t stream = 0)
+            {
+                random_engine.seed(seed_value, stream);
+
+                for_each_player([&](auto &player) { player.set_random_engine(random_engine.split()); });
+            }
+
             // initialize the euchre game
             void init_game()
             {
@@ -73,11 +107,11 @@ namespace rda
                 suit_called_trump = e_suit::INVALID;
                 loner = false;
                 trump_caller_index = euchre_constants::INVALID_INDEX;
+                hands_played = 0;
 
                 scoreboard.reset_score();
 
-                for (auto &player : players)
-                    player->reset();
+                for_each_player([&](auto &player) { player.reset(); });
             }
 
             // initialize a euchre hand
@@ -90,8 +124,7 @@ namespace rda
 
                 scoreboard.reset_hand();
 
-                for (auto &player : players)
-                    player->reset();
+                for_each_player([&](auto &player) { player.reset(); });
             }
 
             // return string representation of this euchre game
@@ -99,18 +132,86 @@ namespace rda
             {
                 std::stringstream ss;
 
-                for (auto &player : players)
-                    ss << "player: " << std::endl
-                       << player->to_string();
+                for_each_player([&](auto &player) { ss << "player: " << std::endl << player.to_string(); });
 
-                ss << "up card: " << up_card.to_string() << std::endl;
+                ss << "up card: " << up_card.name() << std::endl;
 
                 return ss.str();
             }
 
+            // return the scoreboard
+            const euchre_scoreboard &get_scoreboard() const
+            {
+                return scoreboard;
+            }
+
+            // set how every player chooses cards to play by sampling deals
+            void set_pimc_settings(const euchre_algo::pimc_settings &settings)
+            {
+                for_each_player([&](auto &player) { player.set_pimc_settings(settings); });
+            }
+
+            // set how the player at seat index chooses cards to play by sampling deals
+            void set_pimc_settings(const uint8_t seat_index, const euchre_algo::pimc_settings &settings)
+            {
+                get_player(seat_index).set_pimc_settings(settings);
+            }
+
+            // set the weights every player scores trump calls with (nullptr for the weights
+            // currently in use by the engine)
+            void set_trump_call_weights(const std::shared_ptr<const score_trump_call_weights> &weights)
+            {
+                for_each_player([&](auto &player) { player.set_trump_call_weights(weights); });
+            }
+
+            // set the weights the player at seat index scores trump calls with
+            void set_trump_call_weights(const uint8_t seat_index, const std::shared_ptr<const score_trump_call_weights> &weights)
+            {
+                get_player(seat_index).set_trump_call_weights(weights);
+            }
+
+            // add every deal from now on to "log" (nullptr to stop recording). the log must
+            // outlive the game.
+            void set_deal_recorder(euchre_deal_log *log)
+            {
+                deal_recorder = log;
+            }
+
+            // play the deals in "log" in order, starting from deal "first_deal" and wrapping
+            // around at the end, instead of shuffling (nullptr to shuffle again). the dealer of
+            // each hand is taken from the log. the log must outlive the game.
+            void set_deal_source(const euchre_deal_log *log, const size_t first_deal = 0)
+            {
+                deal_source = (log != nullptr && !log->empty()) ? log : nullptr;
+                next_deal = first_deal;
+            }
+
+            // return the player at seat index
+            euchre_player &get_player(const uint8_t seat_index)
+            {
+                euchre_player *player = nullptr;
+                with_player(seat_index, [&player](euchre_player &p) { player = &p; });
+                return *player;
+            }
+
+            // return the player at seat "seat_index", as its own type
+            template <size_t seat_index>
+            auto &get_player()
+            {
+                return std::get<seat_index>(players);
+            }
+
+            // return the number of hands played in the current game
+            uint32_t get_hands_played() const
+            {
+                return hands_played;
+            }
+
             // play the euchre game
             void play_game()
             {
+                init_game();
+
                 dealer_index = determine_dealer();
 
                 while (!scoreboard.is_over())
@@ -123,12 +224,12 @@ namespace rda
             }
 
             // determine seat position of the dealer
-            uint8_t determine_dealer() const
+            uint8_t determine_dealer()
             {
                 // the deck for determining the dealer
                 euchre_deck dealer_deck;
                 dealer_deck.init();
-                dealer_deck.shuffle();
+                dealer_deck.shuffle(random_engine);
 
                 uint8_t position = 0;
 
@@ -147,24 +248,103 @@ namespace rda
                 return 0;
             }
 
+            // play one hand: deal, call trump, play the tricks and score the result
             void play_hand()
             {
                 init_hand();
-                shuffle_deck();
-                deal_hand();
+
+                if (deal_source != nullptr)
+                    replay_deal(deal_source->get(next_deal++ % deal_source->size()));
+                else
+                {
+                    shuffle_deck();
+                    deal_hand();
+                }
+
+                if (deal_recorder != nullptr)
+                    deal_recorder->add(get_deal());
+
                 offer_up_card_trump_to_players();
                 offer_trump_to_players();
 
-                // TODO - continue playing hand
+                ++hands_played;
+
+                if (!headless)
+                    std::cout << to_string() << std::endl;
+
+                // nobody called trump, so the hand is thrown in
+                if (suit_called_trump == e_suit::INVALID)
+                    return;
 
-                std::cout << to_string() << std::endl;
+                play_tricks();
+                scoreboard.score_hand(trump_caller_index, loner);
+            }
+
+            // returns true if the player at seat index sits out this hand (partner of a loner)
+            bool is_sitting_out(const uint8_t seat_index) const
+            {
+                return loner && seat_index == (trump_caller_index + 2) % euchre_constants::NUM_PLAYERS;
+            }
+
+            // play all of the tricks in a hand
+            void play_tricks()
+            {
+                uint8_t leader_index = (dealer_index + 1) % euchre_constants::NUM_PLAYERS;
+
+                if (is_sitting_out(leader_index))
+                    leader_index = (leader_index + 1) % euchre_constants::NUM_PLAYERS;
+
+                std::vector<euchre_card> cards_played;
+                euchre_algo::euchre_trick trick(suit_called_trump);
+
+                for (uint8_t trick_num = 0; trick_num < euchre_constants::EUCHRE_HAND_SIZE; ++trick_num)
+                {
+                    cards_played.clear();
+                    trick.clear();
+
+                    for (uint8_t index = 0; index < euchre_constants::NUM_PLAYERS; ++index)
+                    {
+                        const uint8_t seat_index = (leader_index + index) % euchre_constants::NUM_PLAYERS;
+
+                        if (is_sitting_out(seat_index))
+                            continue;
+
+                        euchre_card card;
+                        with_player(seat_index, [&](auto &player) {
+                            card = player.play_card(cards_played,
+                                                    trump_caller_index,
+                                                    loner,
+                                                    trick_num,
+                                                    scoreboard.team_tricks(seat_index),
+                                                    scoreboard.team_tricks(seat_index + 1));
+                        });
+
+                        cards_played.push_back(card);
+                        trick.play(seat_index, card);
+
+                        update_perceptions_after_card_played(seat_index, card, cards_played.front());
+                    }
+
+                    // the winner of the trick leads the next one
+                    leader_index = trick.winning_seat();
+                    scoreboard.add_trick(leader_index);
+
+                    if (!headless)
+                        std::cout << "trick " << static_cast<int>(trick_num) << " won by player " << static_cast<int>(leader_index) << std::endl;
+                }
+            }
+
+            // update player perceptions after a card was played into a trick
+            void update_perceptions_after_card_played(const uint8_t seat_index, const euchre_card &card, const euchre_card &lead_card)
+            {
+                for_each_player([&](auto &player) { player.update_perceptions_after_card_played(seat_index, card, lead_card); });
             }
 
             // shuffle the deck
             void shuffle_deck()
             {
                 deck.init();
-                deck.shuffle();
+                deck.shuffle(random_engine);
             }
 
             // deal a hand
@@ -176,7 +356,7 @@ namespace rda
 
                 for (auto &a : DEAL_STRATEGY)
                 {
-                    deck.deal(players[deal_pos]->get_hand(), a);
+                    deck.deal(get_player(deal_pos).get_hand(), a);
                     ++deal_pos;
                     deal_pos = deal_pos % euchre_constants::NUM_PLAYERS;
                 }
@@ -186,11 +366,40 @@ namespace rda
                 update_perceptions_after_deal();
             }
 
+            // deal the cards of a recorded deal
+            void replay_deal(const euchre_deal &deal)
+            {
+                dealer_index = deal.dealer_index;
+
+                for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                    for (auto &card : deal.hands[seat])
+                        get_player(seat).get_hand().add_card(card);
+
+                up_card = deal.up_card;
+
+                update_perceptions_after_deal();
+            }
+
+            // return the cards just dealt, before anyone picks up the up card
+            euchre_deal get_deal()
+            {
+                euchre_deal deal;
+                deal.dealer_index = dealer_index;
+                deal.up_card = up_card;
+
+                for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                {
+                    const euchre_hand &hand = get_player(seat).get_hand();
+                    std::copy(hand.cbegin(), hand.cend(), deal.hands[seat].begin());
+                }
+
+                return deal;
+            }
+
             // update player perceptions after initial card deal
             void update_perceptions_after_deal()
             {
-                for (auto &player : players)
-                    player->update_perceptions_after_deal(dealer_index, up_card);
+                for_each_player([&](auto &player) { player.update_perceptions_after_deal(dealer_index, up_card); });
             }
 
             // let players choose if they want the up-card to be trump
@@ -199,7 +408,8 @@ namespace rda
                 for (uint8_t index = 0; index < euchre_constants::NUM_PLAYERS; ++index)
                 {
                     const uint8_t offer_index = (dealer_index + 1 + index) % euchre_constants::NUM_PLAYERS;
-                    const e_trump_decision decision = players[offer_index]->offer_up_card_trump(up_card);
+                    e_trump_decision decision = e_trump_decision::PASS;
+                    with_player(offer_index, [&](auto &player) { decision = player.offer_up_card_trump(up_card); });
 
                     update_perceptions_after_up_card_offer(offer_index, decision);
 
@@ -208,18 +418,18 @@ namespace rda
                         trump_caller_index = offer_index;
                         loner = is_loner(decision);
                         suit_called_trump = up_card.suit();
+                        break;
                     }
                 }
 
                 if (suit_called_trump != e_suit::INVALID)
-                    players[dealer_index]->pick_up_card(up_card);
+                    with_player(dealer_index, [&](auto &player) { player.pick_up_card(up_card); });
             }
 
             // update player perceptions after a player was offered to order up trump
             void update_perceptions_after_up_card_offer(const uint8_t seat_index, const e_trump_decision decision)
             {
-                for (auto &player : players)
-                    player->update_perceptions_after_up_card_offer(seat_index, decision);
+                for_each_player([&](auto &player) { player.update_perceptions_after_up_card_offer(seat_index, decision); });
             }
 
             // let players choose to call trump, if it hasn't been called already
@@ -230,12 +440,14 @@ namespace rda
                     for (uint8_t index = 0; index < euchre_constants::NUM_PLAYERS; ++index)
                     {
                         const uint8_t offer_index = (dealer_index + 1 + index) % euchre_constants::NUM_PLAYERS;
-                        const e_trump_decision decision = players[offer_index]->offer_trump();
+                        e_trump_decision decision = e_trump_decision::PASS;
+                        with_player(offer_index, [&](auto &player) { decision = player.offer_trump(); });
 
                         update_perceptions_after_trump_offer(offer_index, decision);
 
                         if (is_calling_suit(decision))
                         {
+                            trump_caller_index = offer_index;
                             suit_called_trump = decision_to_suit(decision);
                             loner = is_loner(decision);
                             break;
@@ -247,11 +459,57 @@ namespace rda
             // update player perceptions after a player was offered to call any trump
             void update_perceptions_after_trump_offer(const uint8_t seat_index, const e_trump_decision decision)
             {
-                for (auto &player : players)
-                    player->update_perceptions_after_trump_offer(seat_index, decision);
+                for_each_player([&](auto &player) { player.update_perceptions_after_trump_offer(seat_index, decision); });
             }
 
-        }; // class euchre_game
+        private:
+            // call "f" with the player at seat index, as its own type
+            template <typename function_type>
+            void with_player(const uint8_t seat_index, function_type &&f)
+            {
+                switch (seat_index)
+                {
+                    case 0:
+                        f(std::get<0>(players));
+                        break;
+                    case 1:
+                        f(std::get<1>(players));
+                        break;
+                    case 2:
+                        f(std::get<2>(players));
+                        break;
+                    default:
+                        f(std::get<3>(players));
+                        break;
+                }
+            }
+
+            // call "f" with each player in seat order, as its own type
+            template <typename function_type>
+            void for_each_player(function_type &&f)
+            {
+                f(std::get<0>(players));
+                f(std::get<1>(players));
+                f(std::get<2>(players));
+                f(std::get<3>(players));
+            }
+
+            template <typename function_type>
+            void for_each_player(function_type &&f) const
+            {
+                f(std::get<0>(players));
+                f(std::get<1>(players));
+                f(std::get<2>(players));
+                f(std::get<3>(players));
+            }
+
+        }; // class basic_euchre_game
+
+        // the game as played at the table: a human player and three computer players
+        typedef basic_euchre_game<euchre_player_human, euchre_player_computer, euchre_player_computer, euchre_player_computer> euchre_game;
+
+        // a game of four computer players, for simulations
+        typedef basic_euchre_game<euchre_player_computer, euchre_player_computer, euchre_player_computer, euchre_player_computer> euchre_computer_game;
 
     } // namespace euchre
 
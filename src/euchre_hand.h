@@ -7,10 +7,14 @@
 //
 
 #include <algorithm>
+#include <array>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_constants.h"
 
 namespace rda
 {
@@ -19,79 +23,124 @@ namespace rda
         // hand of cards in a euchre game
         class euchre_hand
         {
+        public:
+            // iterator type over the cards in the hand
+            typedef const euchre_card *const_iterator;
+
         private:
-            // the cards in the hand
-            std::vector<euchre_card> cards;
+            // the cards in the hand, in the order they were added
+            std::array<euchre_card, euchre_constants::MAX_HAND_SIZE> cards;
+
+            // the number of cards in the hand
+            uint8_t count = 0;
+
+            // bitmask of the cards in the hand
+            euchre_card_mask card_mask = euchre_mask::EMPTY;
 
         public:
-            // add one card to the hand
+            // add one card to the hand (ignored if the hand is full or already holds the card)
             void add_card(const euchre_card &c)
             {
-                cards.push_back(c);
+                const euchre_card_mask bit = euchre_mask::card_bit(c);
+
+                if (count >= cards.size() || (card_mask & bit))
+                    return;
+
+                cards[count++] = c;
+                card_mask |= bit;
             }
 
             // add vector of cards to the hand
             void add_cards(const std::vector<euchre_card> &new_cards)
             {
-                cards.insert(cards.end(), new_cards.cbegin(), new_cards.cend());
+                for (auto &c : new_cards)
+                    add_card(c);
             }
 
             // remove a card from the hand
             void remove_card(const euchre_card &c)
             {
-                cards.erase(std::remove(cards.begin(), cards.end(), c));
+                auto iter = std::find(cards.begin(), cards.begin() + count, c);
+
+                if (iter == cards.begin() + count)
+                    return;
+
+                std::copy(iter + 1, cards.begin() + count, iter);
+                --count;
+                card_mask &= ~euchre_mask::card_bit(c);
             }
 
             // set the cards of the hand
             void set_cards(const std::vector<euchre_card> &c)
             {
-                cards = c;
+                clear();
+                add_cards(c);
             }
 
             // clear all cards from the hand
             void clear()
             {
-                cards.clear();
+                count = 0;
+                card_mask = euchre_mask::EMPTY;
             }
 
             // return true if hand contains a card
             bool contains(const euchre_card &c) const
             {
-                return std::find(cards.cbegin(), cards.cend(), c) != cards.cend();
+                const euchre_card_mask bit = euchre_mask::card_bit(c);
+                return bit != euchre_mask::EMPTY && (card_mask & bit) == bit;
             }
 
             // returns true if hand contains all of given cards
             bool contains(const std::vector<euchre_card> &c) const
             {
                 for (auto &a : c)
-                    if (std::find(cards.cbegin(), cards.cend(), a) == cards.cend())
+                    if (!contains(a))
                         return false;
 
                 return true;
             }
 
+            // returns true if hand contains all cards of the given mask
+            bool contains_all(const euchre_card_mask m) const
+            {
+                return euchre_mask::contains_all(card_mask, m);
+            }
+
+            // return the bitmask of cards in the hand
+            euchre_card_mask mask() const
+            {
+                return card_mask;
+            }
+
+            // return the number of cards in the hand whose effective suit is "suit"
+            uint8_t count_suit(const e_suit suit, const e_suit trump) const
+            {
+                return euchre_mask::popcount(card_mask & euchre_mask::effective_suit_mask(suit, trump));
+            }
+
             // return the number of cards in the hand
             size_t size() const
             {
-                return cards.size();
+                return count;
             }
 
             // returns true if the hand is empty
             bool empty() const
             {
-                return cards.empty();
+                return count == 0;
             }
 
             // const iterator for beginning of cards
-            std::vector<euchre_card>::const_iterator cbegin() const
+            const_iterator cbegin() const
             {
-                return cards.cbegin();
+                return cards.data();
             }
 
             // const iterator for end of cards
-            std::vector<euchre_card>::const_iterator cend() const
+            const_iterator cend() const
             {
-                return cards.cend();
+                return cards.data() + count;
             }
 
             // return a string representation of the hand
@@ -100,8 +149,8 @@ namespace rda
                 std::stringstream ss;
 
                 ss << "hand:  ";
-                for (auto &c : cards)
-                    ss << " " << c.to_string();
+                for (auto iter = cbegin(); iter != cend(); ++iter)
+                    ss << " " << iter->name();
                 ss << std::endl;
 
                 return ss.str();
@@ -6,10 +6,12 @@
 // Written by Ryan Antkowiak 
 //
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
 #include "euchre_card.h"
+#include "euchre_card_mask.h"
 #include "euchre_constants.h"
 #include "euchre_seat_position.h"
 #include "euchre_trump_decision.h"
@@ -39,6 +41,9 @@ namespace rda
             // decision the player made after being offered to call any other trump suit
             e_trump_decision call_trump_offer_decision = e_trump_decision::INVALID;
 
+            // the trump suit, once called by anyone
+            e_suit trump_suit = e_suit::INVALID;
+
             // cards that this player has played
             std::vector<euchre_card> cards_played;
 
@@ -63,6 +68,7 @@ namespace rda
                 up_card = euchre_card();
                 up_card_offer_decision = e_trump_decision::INVALID;
                 call_trump_offer_decision = e_trump_decision::INVALID;
+                trump_suit = e_suit::INVALID;
 
                 cards_played.clear();
                 cards_in_hand.clear();
@@ -86,6 +92,9 @@ namespace rda
                 if (offer_index == seat_index)
                     up_card_offer_decision = decision;
 
+                if (is_ordering_up(decision))
+                    trump_suit = up_card.suit();
+
                 // if this is the perception of the dealer
                 if (dealer_position == euchre_seat_position::SELF)
                 {
@@ -102,6 +111,76 @@ namespace rda
             {
                 if (offer_index == seat_index)
                     call_trump_offer_decision = decision;
+
+                if (is_calling_suit(decision))
+                    trump_suit = decision_to_suit(decision);
+            }
+
+            // update after a card was played into a trick (lead_card is the first card of the trick)
+            void update_after_card_played(const uint8_t played_index, const euchre_card &card, const euchre_card &lead_card)
+            {
+                if (played_index == seat_index)
+                {
+                    cards_played.push_back(card);
+                    cards_in_hand.erase(std::remove(cards_in_hand.begin(), cards_in_hand.end(), card), cards_in_hand.end());
+
+                    // failing to follow suit shows the player holds no other cards of the suit lead
+                    if (trump_suit != e_suit::INVALID)
+                    {
+                        const e_suit suit_lead = effective_suit(lead_card);
+
+                        if (effective_suit(card) != suit_lead)
+                            for (euchre_card_mask m = euchre_mask::effective_suit_mask(suit_lead, trump_suit); m != 0; m &= m - 1)
+                                add_card_not_in_hand(euchre_mask::card_from_index(euchre_mask::lowest_index(m)));
+                    }
+                }
+            }
+
+            // returns the mask of cards known to be in this player's hand
+            euchre_card_mask get_cards_in_hand_mask() const
+            {
+                euchre_card_mask m = euchre_mask::EMPTY;
+
+                for (auto &c : cards_in_hand)
+                    m |= euchre_mask::card_bit(c);
+
+                return m;
+            }
+
+            // returns the mask of cards known to NOT be in this player's hand
+            euchre_card_mask get_cards_not_in_hand_mask() const
+            {
+                euchre_card_mask m = euchre_mask::EMPTY;
+
+                for (auto &c : cards_not_in_hand)
+                    m |= euchre_mask::card_bit(c);
+
+                return m;
+            }
+
+            // returns the mask of cards this player has played
+            euchre_card_mask get_cards_played_mask() const
+            {
+                euchre_card_mask m = euchre_mask::EMPTY;
+
+                for (auto &c : cards_played)
+                    m |= euchre_mask::card_bit(c);
+
+                return m;
+            }
+
+        private:
+            // returns the suit a card belongs to, with the left bower counted as trump
+            e_suit effective_suit(const euchre_card &card) const
+            {
+                return (euchre_mask::card_bit(card) & euchre_mask::trump_mask(trump_suit)) ? trump_suit : card.suit();
+            }
+
+            // add a card to the cards known to NOT be in this player's hand, if not already there
+            void add_card_not_in_hand(const euchre_card &card)
+            {
+                if (std::find(cards_not_in_hand.cbegin(), cards_not_in_hand.cend(), card) == cards_not_in_hand.cend())
+                    cards_not_in_hand.push_back(card);
             }
 
         }; // class euchre_perception
@@ -8,12 +8,17 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "euchre_algo_choose_card_to_play.h"
 #include "euchre_algo_discarder.h"
+#include "euchre_algo_pimc.h"
+#include "euchre_algo_trick.h"
 #include "euchre_card.h"
+#include "euchre_card_mask.h"
 #include "euchre_card_rank.h"
 #include "euchre_card_suit.h"
 #include "euchre_constants.h"
@@ -25,12 +30,16 @@
 #include "random_seeder.h"
 #include "score_trump_call.h"
 #include "score_trump_call_context.h"
+#include "score_trump_call_weights.h"
 
 namespace rda
 {
     namespace euchre
     {
-        // player in a euchre game
+        // player in a euchre game. the game calls the public methods, which keep track of what
+        // the player has seen. the decisions (bidding, discarding and playing) are made by the
+        // protected virtual methods, which a strategy overrides. the defaults are the computer
+        // strategy.
         class euchre_player
         {
         protected:
@@ -61,13 +70,26 @@ namespace rda
             // all the info that this player knows about the opponent to the right
             euchre_perception m_right_perception;
 
+            // cards this player has played so far in the hand
+            std::vector<euchre_card> m_cards_played;
+
+            // settings for choosing cards to play by sampling deals
+            euchre_algo::pimc_settings m_pimc_settings;
+
+            // weights for scoring trump calls (nullptr to use the weights currently in use by the engine)
+            std::shared_ptr<const score_trump_call_weights> m_trump_call_weights;
+
+            // the player's own random engine
+            euchre_random_engine m_random_engine;
+
         public:
             // constructor
             euchre_player(const uint8_t seat_index)
                 : m_seat_index(seat_index),
                   m_left_perception((seat_index + 1) % euchre_constants::NUM_PLAYERS),
                   m_partner_perception((seat_index + 2) % euchre_constants::NUM_PLAYERS),
-                  m_right_perception((seat_index + 3) % euchre_constants::NUM_PLAYERS)
+                  m_right_perception((seat_index + 3) % euchre_constants::NUM_PLAYERS),
+                  m_random_engine(make_random_seed(), seat_index)
             {
             }
 
@@ -87,6 +109,8 @@ namespace rda
                 m_left_perception.reset();
                 m_partner_perception.reset();
                 m_right_perception.reset();
+
+                m_cards_played.clear();
             }
 
             // return string representation of this player
@@ -103,6 +127,25 @@ namespace rda
                 return m_hand;
             }
 
+            // set the player's random engine (a game gives each player its own stream)
+            void set_random_engine(const euchre_random_engine &engine)
+            {
+                m_random_engine = engine;
+            }
+
+            // set how cards to play are chosen by sampling deals (0 samples to not sample)
+            void set_pimc_settings(const euchre_algo::pimc_settings &settings)
+            {
+                m_pimc_settings = settings;
+            }
+
+            // set the weights for scoring trump calls (nullptr to use the weights currently in use
+            // by the engine)
+            void set_trump_call_weights(const std::shared_ptr<const score_trump_call_weights> &weights)
+            {
+                m_trump_call_weights = weights;
+            }
+
             // update perceptions of over players, after the initial cards have been dealt
             void update_perceptions_after_deal(const uint8_t dealer_index, const euchre_card &up_card)
             {
@@ -121,26 +164,7 @@ namespace rda
             // handle an offer of making the up_card trump
             e_trump_decision offer_up_card_trump(const euchre_card &up_card)
             {
-                // score the situation
-                const score_trump_call_context ctx = score_trump_call::score(up_card.suit(),
-                                                                             m_hand,
-                                                                             up_card,
-                                                                             false,
-                                                                             m_dealer_position,
-                                                                             m_left_perception,
-                                                                             m_partner_perception,
-                                                                             m_right_perception);
-
-                // check if should order up for a loner
-                if (ctx.get_total_score() >= ctx.get_loner_call_threshold())
-                    return e_trump_decision::ORDER_UP_LONER;
-
-                // check if should order up
-                if (ctx.get_total_score() >= ctx.get_trump_call_threshold())
-                    return e_trump_decision::ORDER_UP;
-
-                // not a good hand, pass
-                return e_trump_decision::PASS;
+                return choose_up_card_trump(up_card);
             }
 
             // update perceptions of other players, after getting the result of an offer of trump from an up-card
@@ -154,88 +178,174 @@ namespace rda
                 m_right_perception.update_after_up_card_offer(seat_index, decision);
             }
 
-            // pick up the up-card into the player's hand
+            // pick up the up-card into the player's hand, and discard a card
             void pick_up_card(const euchre_card &card)
             {
                 m_hand.add_card(card);
-                euchre_algo::discarder(m_hand, card, card.suit());
+                choose_discard(card);
             }
 
             // handle an offer of calling any trump suit
             e_trump_decision offer_trump()
             {
-                // start with all suits
-                std::vector<e_suit> suits = {e_suit::CLUBS, e_suit::DIAMONDS, e_suit::HEARTS, e_suit::SPADES};
+                return choose_trump();
+            }
+
+            // update perceptino of other players, after getting results of an offer for someone to call trump
+            void update_perceptions_after_trump_offer(const uint8_t seat_index, const e_trump_decision decision)
+            {
+                if (is_calling_suit(decision))
+                    m_suit_called_trump = decision_to_suit(decision);
+
+                const e_suit suit = decision_to_suit(decision);
+
+                if (suit != e_suit::INVALID)
+                    m_suit_called_trump = suit;
+
+                m_left_perception.update_after_trump_offer(seat_index, decision);
+                m_partner_perception.update_after_trump_offer(seat_index, decision);
+                m_right_perception.update_after_trump_offer(seat_index, decision);
+            }
+
+            // choose a card to play into the current trick, and remove it from the hand. a card
+            // that may not be played (not in the hand, or not following suit when the hand can)
+            // is replaced by the lowest card that may be played.
+            euchre_card play_card(const std::vector<euchre_card> &cards_played,
+                                  const uint8_t trump_caller_index,
+                                  const bool loner,
+                                  const uint8_t trick_num,
+                                  const uint8_t num_tricks_team,
+                                  const uint8_t num_tricks_opponent)
+            {
+                euchre_card card = choose_card(cards_played, trump_caller_index, loner, trick_num, num_tricks_team, num_tricks_opponent);
 
-                // remove the "up card" suit from consideration
-                auto unused = std::remove(suits.begin(), suits.end(), m_up_card.suit());
-                static_cast<void>(unused);
+                const euchre_card_mask legal = euchre_algo::legal_moves(euchre_algo::get_trick_table(m_suit_called_trump),
+                                                                        m_hand.mask(),
+                                                                        cards_played.empty() ? static_cast<uint8_t>(euchre_constants::NUM_CARDS) : euchre_mask::card_index(cards_played.front()));
 
-                // randomize the order of the suits
-                rda::euchre::seed_randomizer();
-                std::random_shuffle(suits.begin(), suits.end());
+                if (!(legal & euchre_mask::card_bit(card)) && legal != 0)
+                    card = euchre_mask::card_from_index(euchre_mask::lowest_index(legal));
 
-                // create a vector for all of the suit scoring contexts
-                std::vector<score_trump_call_context> contexts;
+                m_hand.remove_card(card);
+                m_cards_played.push_back(card);
+
+                return card;
+            }
+
+            // update perceptions of other players, after a card was played into a trick
+            void update_perceptions_after_card_played(const uint8_t seat_index, const euchre_card &card, const euchre_card &lead_card)
+            {
+                m_left_perception.update_after_card_played(seat_index, card, lead_card);
+                m_partner_perception.update_after_card_played(seat_index, card, lead_card);
+                m_right_perception.update_after_card_played(seat_index, card, lead_card);
+            }
 
-                // initialize max_score and best index
+        protected:
+            // return the weights this player scores trump calls with
+            std::shared_ptr<const score_trump_call_weights> trump_call_weights() const
+            {
+                return (m_trump_call_weights != nullptr) ? m_trump_call_weights : score_trump_call_weights::current();
+            }
+
+            // decide whether to order up the up card as trump
+            virtual e_trump_decision choose_up_card_trump(const euchre_card &up_card)
+            {
+                // score the situation (the context refers to the weights, so they are held here)
+                const auto weights = trump_call_weights();
+                const score_trump_call_context ctx = score_trump_call::score(weights,
+                                                                             up_card.suit(),
+                                                                             m_hand,
+                                                                             up_card,
+                                                                             false,
+                                                                             m_dealer_position,
+                                                                             m_left_perception,
+                                                                             m_partner_perception,
+                                                                             m_right_perception);
+
+                // check if should order up for a loner
+                if (ctx.get_total_score() >= ctx.get_loner_call_threshold())
+                    return e_trump_decision::ORDER_UP_LONER;
+
+                // check if should order up
+                if (ctx.get_total_score() >= ctx.get_trump_call_threshold())
+                    return e_trump_decision::ORDER_UP;
+
+                // not a good hand, pass
+                return e_trump_decision::PASS;
+            }
+
+            // discard a card from the hand, after picking up "card_added"
+            virtual void choose_discard(const euchre_card &card_added)
+            {
+                euchre_algo::discarder(m_hand, card_added, card_added.suit(), m_random_engine);
+            }
+
+            // decide whether to call a trump suit, after the up card was turned down
+            virtual e_trump_decision choose_trump()
+            {
+                const auto weights = trump_call_weights();
+
+                // score every suit in one pass
+                const score_trump_call::suit_scores scores = score_trump_call::score_suits(weights,
+                                                                                            m_hand,
+                                                                                            m_up_card,
+                                                                                            false,
+                                                                                            m_dealer_position,
+                                                                                            m_left_perception,
+                                                                                            m_partner_perception,
+                                                                                            m_right_perception);
+
+                // find the best suit other than the "up card" suit. ties go to the first suit.
                 double max_score = std::numeric_limits<double>::lowest();
-                size_t best_score_index = 0;
+                e_suit best_suit = e_suit::INVALID;
 
-                // iterate over the suits
-                for (size_t i = 0; i < suits.size(); ++i)
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
                 {
-                    // create the score context for this suit
-                    contexts.push_back(score_trump_call::score(suits[i],
-                                                               m_hand,
-                                                               m_up_card,
-                                                               false,
-                                                               m_dealer_position,
-                                                               m_left_perception,
-                                                               m_partner_perception,
-                                                               m_right_perception));
-
-                    // extract the score
-                    const double suit_score = contexts[i].get_total_score();
-
-                    // check if the score is the best
-                    if (suit_score > max_score)
+                    if (s != m_up_card.suit() && scores[static_cast<size_t>(s)] > max_score)
                     {
-                        max_score = suit_score;
-                        best_score_index = i;
+                        max_score = scores[static_cast<size_t>(s)];
+                        best_suit = s;
                     }
                 }
 
                 // if a best score was found
-                if (best_score_index < contexts.size())
+                if (best_suit != e_suit::INVALID)
                 {
                     // check if the score meets or exceeds the loner-call threshold
-                    if (contexts[best_score_index].get_total_score() >= contexts[best_score_index].get_loner_call_threshold())
-                        return suit_to_loner_call(contexts[best_score_index].m_suit);
+                    if (max_score >= weights->get(e_trump_call_term::LONER_CALL_THRESHOLD))
+                        return suit_to_loner_call(best_suit);
 
                     // check if the score meets or exceeds the trump-call threshold
-                    if (contexts[best_score_index].get_total_score() >= contexts[best_score_index].get_trump_call_threshold())
-                        return suit_to_call(contexts[best_score_index].m_suit);
+                    if (max_score >= weights->get(e_trump_call_term::TRUMP_CALL_THRESHOLD))
+                        return suit_to_call(best_suit);
                 }
 
                 // not a good enough hand, so pass
                 return e_trump_decision::PASS;
             }
 
-            // update perceptino of other players, after getting results of an offer for someone to call trump
-            void update_perceptions_after_trump_offer(const uint8_t seat_index, const e_trump_decision decision)
+            // choose a card from the hand to play into the current trick
+            virtual euchre_card choose_card(const std::vector<euchre_card> &cards_played,
+                                            const uint8_t trump_caller_index,
+                                            const bool loner,
+                                            const uint8_t trick_num,
+                                            const uint8_t num_tricks_team,
+                                            const uint8_t num_tricks_opponent)
             {
-                if (is_calling_suit(decision))
-                    m_suit_called_trump = decision_to_suit(decision);
-
-                const e_suit suit = decision_to_suit(decision);
-
-                if (suit != e_suit::INVALID)
-                    m_suit_called_trump = suit;
-
-                m_left_perception.update_after_trump_offer(seat_index, decision);
-                m_partner_perception.update_after_trump_offer(seat_index, decision);
-                m_right_perception.update_after_trump_offer(seat_index, decision);
+                return euchre_algo_choose_card_to_play::choose_card(cards_played,
+                                                                    m_suit_called_trump,
+                                                                    m_hand,
+                                                                    euchre_utils::relative_seat_position(m_seat_index, trump_caller_index),
+                                                                    trick_num,
+                                                                    num_tricks_team,
+                                                                    num_tricks_opponent,
+                                                                    loner,
+                                                                    m_left_perception,
+                                                                    m_partner_perception,
+                                                                    m_right_perception,
+                                                                    m_cards_played,
+                                                                    m_pimc_settings,
+                                                                    m_random_engine);
             }
 
         }; // class euchre_player
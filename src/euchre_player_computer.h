@@ -15,7 +15,7 @@ namespace rda
     namespace euchre
     {
         // computer player in a euchre game
-        class euchre_player_computer : public euchre_player
+        class euchre_player_computer final : public euchre_player
         {
         public:
             euchre_player_computer(const uint8_t pos)
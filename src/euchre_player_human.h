@@ -15,7 +15,7 @@ namespace rda
     namespace euchre
     {
         // human player in a euchre game
-        class euchre_player_human : public euchre_player
+        class euchre_player_human final : public euchre_player
         {
         public:
             euchre_player_human(const uint8_t pos)
@@ -8,6 +8,8 @@
 
 #include <cstdint>
 
+#include "euchre_constants.h"
+
 namespace rda
 {
     namespace euchre
@@ -41,6 +43,52 @@ namespace rda
                 team2_tricks = 0;
             }
 
+            // returns true if the seat index belongs to team 1 (team 2 otherwise)
+            static bool is_team1(const uint8_t seat_index)
+            {
+                return seat_index % 2 == 0;
+            }
+
+            // record a trick won by the player at a seat index
+            void add_trick(const uint8_t seat_index)
+            {
+                if (is_team1(seat_index))
+                    ++team1_tricks;
+                else
+                    ++team2_tricks;
+            }
+
+            // return the number of tricks taken this hand by the team of the seat index
+            uint8_t team_tricks(const uint8_t seat_index) const
+            {
+                return is_team1(seat_index) ? team1_tricks : team2_tricks;
+            }
+
+            // award points for the hand just played, given who called trump
+            void score_hand(const uint8_t trump_caller_index, const bool loner)
+            {
+                const uint8_t maker_tricks = team_tricks(trump_caller_index);
+
+                uint8_t points = 0;
+                bool makers_scored = true;
+
+                if (maker_tricks == euchre_constants::EUCHRE_HAND_SIZE)
+                    points = loner ? 4 : 2;
+                else if (maker_tricks >= 3)
+                    points = 1;
+                else
+                {
+                    // the makers were euchred
+                    points = 2;
+                    makers_scored = false;
+                }
+
+                if (is_team1(trump_caller_index) == makers_scored)
+                    team1_score += points;
+                else
+                    team2_score += points;
+            }
+
             // return true if game is over
             bool is_over() const
             {
@@ -0,0 +1,249 @@
+#pragma once
+
+//
+// euchre_simulator.h - Headless batch simulation of euchre games
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "euchre_algo_pimc.h"
+#include "euchre_deal_log.h"
+#include "euchre_game.h"
+#include "random_seeder.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        // aggregate results of a batch of simulated games
+        struct euchre_simulation_result
+        {
+            // number of games played
+            uint64_t games = 0;
+
+            // number of hands played
+            uint64_t hands = 0;
+
+            // number of games won by each team
+            uint64_t team1_wins = 0;
+            uint64_t team2_wins = 0;
+
+            // total points scored by each team
+            uint64_t team1_points = 0;
+            uint64_t team2_points = 0;
+
+            // wall clock time spent simulating
+            double seconds = 0.0f;
+
+            // return the number of games simulated per second
+            double games_per_second() const
+            {
+                return seconds > 0.0f ? games / seconds : 0.0f;
+            }
+
+            // add the result of one finished game
+            template <typename game_type>
+            void add_game(const game_type &game)
+            {
+                const euchre_scoreboard &scoreboard = game.get_scoreboard();
+
+                ++games;
+                hands += game.get_hands_played();
+
+                team1_points += scoreboard.team1_score;
+                team2_points += scoreboard.team2_score;
+
+                if (scoreboard.team1_score > scoreboard.team2_score)
+                    ++team1_wins;
+                else
+                    ++team2_wins;
+            }
+
+            // add the results of another batch (wall clock time is not added)
+            void merge(const euchre_simulation_result &rhs)
+            {
+                games += rhs.games;
+                hands += rhs.hands;
+                team1_wins += rhs.team1_wins;
+                team2_wins += rhs.team2_wins;
+                team1_points += rhs.team1_points;
+                team2_points += rhs.team2_points;
+            }
+
+            // return the fraction of games won by team 1
+            double team1_win_rate() const
+            {
+                return games > 0 ? static_cast<double>(team1_wins) / games : 0.0f;
+            }
+
+            // return a string representation of the result
+            std::string to_string() const
+            {
+                std::stringstream ss;
+
+                ss << "games: " << games
+                   << " hands: " << hands
+                   << " team1_wins: " << team1_wins
+                   << " team2_wins: " << team2_wins
+                   << " team1_points: " << team1_points
+                   << " team2_points: " << team2_points
+                   << " seconds: " << seconds
+                   << " games/sec: " << games_per_second();
+
+                return ss.str();
+            }
+        };
+
+        // play games [first_game, first_game + num_games) back-to-back on the calling thread, with
+        // no output. game i is seeded with (seed, i), so each game is the same whichever thread
+        // plays it.
+        static euchre_simulation_result simulate_games(const uint64_t first_game,
+                                                       const uint64_t num_games,
+                                                       const uint64_t seed,
+                                                       const euchre_algo::pimc_settings &settings = euchre_algo::pimc_settings())
+        {
+            euchre_simulation_result result;
+            euchre_computer_game game(true, seed);
+            game.set_pimc_settings(settings);
+
+            for (uint64_t i = first_game; i < first_game + num_games; ++i)
+            {
+                game.seed(seed, i);
+                game.play_game();
+                result.add_game(game);
+            }
+
+            return result;
+        }
+
+        // play games [0, num_games) on the calling thread like simulate_games, adding every deal
+        // to "log"
+        static euchre_simulation_result record_games(const uint64_t num_games,
+                                                     const uint64_t seed,
+                                                     euchre_deal_log &log,
+                                                     const euchre_algo::pimc_settings &settings = euchre_algo::pimc_settings())
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            euchre_simulation_result result;
+            euchre_computer_game game(true, seed);
+            game.set_pimc_settings(settings);
+            game.set_deal_recorder(&log);
+
+            for (uint64_t i = 0; i < num_games; ++i)
+            {
+                game.seed(seed, i);
+                game.play_game();
+                result.add_game(game);
+            }
+
+            const auto finish = std::chrono::steady_clock::now();
+            result.seconds = std::chrono::duration<double>(finish - start).count();
+
+            return result;
+        }
+
+        // play games [0, num_games) on the calling thread like simulate_games, dealing the hands
+        // from "deals" in order instead of shuffling. replaying the deals recorded by
+        // record_games with the same seed plays the same games.
+        static euchre_simulation_result replay_games(const uint64_t num_games,
+                                                     const uint64_t seed,
+                                                     const euchre_deal_log &deals,
+                                                     const euchre_algo::pimc_settings &settings = euchre_algo::pimc_settings())
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            euchre_simulation_result result;
+            euchre_computer_game game(true, seed);
+            game.set_pimc_settings(settings);
+            game.set_deal_source(&deals);
+
+            for (uint64_t i = 0; i < num_games; ++i)
+            {
+                game.seed(seed, i);
+                game.play_game();
+                result.add_game(game);
+            }
+
+            const auto finish = std::chrono::steady_clock::now();
+            result.seconds = std::chrono::duration<double>(finish - start).count();
+
+            return result;
+        }
+
+        // play a number of complete games back-to-back, with no output. the same seed plays the
+        // same games.
+        static euchre_simulation_result run_simulation(const uint64_t num_games,
+                                                       const uint64_t seed,
+                                                       const euchre_algo::pimc_settings &settings = euchre_algo::pimc_settings())
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            euchre_simulation_result result = simulate_games(0, num_games, seed, settings);
+
+            const auto finish = std::chrono::steady_clock::now();
+            result.seconds = std::chrono::duration<double>(finish - start).count();
+
+            return result;
+        }
+
+        // shard a number of games across worker threads. each worker fills its own result slot,
+        // and the slots are merged after all workers are joined, so no locks are taken while
+        // simulating. each game is seeded from (seed, game number), so a given seed reproduces
+        // the same totals with any number of threads.
+        static euchre_simulation_result run_parallel_simulation(const uint64_t num_games,
+                                                                const uint64_t seed,
+                                                                const unsigned int num_threads = std::thread::hardware_concurrency(),
+                                                                const euchre_algo::pimc_settings &settings = euchre_algo::pimc_settings())
+        {
+            const unsigned int workers = (num_threads == 0) ? 1 : num_threads;
+
+            std::vector<euchre_simulation_result> worker_results(workers);
+            std::vector<std::thread> threads;
+            threads.reserve(workers);
+
+            const auto start = std::chrono::steady_clock::now();
+
+            for (unsigned int w = 0; w < workers; ++w)
+            {
+                // games [first, last) belong to this worker
+                const uint64_t first = num_games * w / workers;
+                const uint64_t last = num_games * (w + 1) / workers;
+
+                threads.emplace_back([&worker_results, &settings, w, first, last, seed]() {
+                    worker_results[w] = simulate_games(first, last - first, seed, settings);
+                });
+            }
+
+            for (auto &t : threads)
+                t.join();
+
+            const auto finish = std::chrono::steady_clock::now();
+
+            euchre_simulation_result result;
+
+            for (auto &r : worker_results)
+                result.merge(r);
+
+            result.seconds = std::chrono::duration<double>(finish - start).count();
+
+            return result;
+        }
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
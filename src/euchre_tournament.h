@@ -0,0 +1,254 @@
+#pragma once
+
+//
+// euchre_tournament.h - Duplicate tournament between two ways of playing
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "euchre_algo_pimc.h"
+#include "euchre_card.h"
+#include "euchre_constants.h"
+#include "euchre_deal_log.h"
+#include "euchre_deck.h"
+#include "euchre_game.h"
+#include "random_seeder.h"
+#include "score_trump_call_weights.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        // results of a duplicate tournament. points are contender a minus contender b, per hand.
+        struct euchre_duplicate_result
+        {
+            // number of boards played (each board is one deal, played twice)
+            uint64_t boards = 0;
+
+            // total points scored by each contender
+            uint64_t a_points = 0;
+            uint64_t b_points = 0;
+
+            // mean point differential per hand
+            double mean = 0.0f;
+
+            // standard error of the mean, from the paired board results
+            double std_error = 0.0f;
+
+            // standard error of the mean if the hands were treated as unrelated, for comparison
+            double unpaired_std_error = 0.0f;
+
+            // wall clock time spent playing
+            double seconds = 0.0f;
+
+            // return the lower and upper ends of the 95% confidence interval of the mean
+            double ci95_low() const
+            {
+                return mean - 1.96f * std_error;
+            }
+
+            double ci95_high() const
+            {
+                return mean + 1.96f * std_error;
+            }
+
+            // return a string representation of the result
+            std::string to_string() const
+            {
+                std::stringstream ss;
+
+                ss << "boards: " << boards
+                   << " a_points: " << a_points
+                   << " b_points: " << b_points
+                   << " mean: " << mean
+                   << " std_error: " << std_error
+                   << " ci95: [" << ci95_low() << ", " << ci95_high() << "]"
+                   << " unpaired_std_error: " << unpaired_std_error
+                   << " seconds: " << seconds;
+
+                return ss.str();
+            }
+        };
+
+        // one side of a duplicate tournament: how its players choose cards to play, and the
+        // weights they score trump calls with (nullptr for the weights currently in use)
+        struct euchre_contender
+        {
+            euchre_algo::pimc_settings settings;
+            std::shared_ptr<const score_trump_call_weights> weights;
+        };
+
+        // shuffle and deal a number of boards. board i is dealt from (seed, i), and dealer i
+        // rotates around the table.
+        static euchre_deal_log make_random_deals(const uint64_t num_boards, const uint64_t seed)
+        {
+            euchre_deal_log log;
+            euchre_deck deck;
+
+            for (uint64_t i = 0; i < num_boards; ++i)
+            {
+                euchre_random_engine engine(seed, i);
+                deck.init();
+                deck.shuffle(engine);
+
+                euchre_deal deal;
+                deal.dealer_index = static_cast<uint8_t>(i % euchre_constants::NUM_PLAYERS);
+
+                for (auto &hand : deal.hands)
+                    for (auto &card : hand)
+                        card = deck.draw();
+
+                deal.up_card = deck.draw();
+
+                log.add(deal);
+            }
+
+            return log;
+        }
+
+        // play boards [first_board, first_board + num_boards) on the calling thread. each board is
+        // played twice with the same cards in the same seats: first with contender a in seats 0
+        // and 2, then with a in seats 1 and 3. the points a scored minus the points b scored in
+        // each hand go into "results" (two per board).
+        static void play_duplicate_boards(const euchre_deal_log &deals,
+                                          const uint64_t first_board,
+                                          const uint64_t num_boards,
+                                          const uint64_t seed,
+                                          const euchre_contender &a,
+                                          const euchre_contender &b,
+                                          std::vector<int> &results)
+        {
+            euchre_computer_game game(true, seed);
+
+            for (uint64_t board = first_board; board < first_board + num_boards; ++board)
+            {
+                for (uint8_t table = 0; table < 2; ++table)
+                {
+                    for (uint8_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                    {
+                        const euchre_contender &contender = ((seat + table) % 2 == 0) ? a : b;
+                        game.set_pimc_settings(seat, contender.settings);
+                        game.set_trump_call_weights(seat, contender.weights);
+                    }
+
+                    // both tables make the same random choices
+                    game.seed(seed, board);
+                    game.init_game();
+                    game.set_deal_source(&deals, board);
+                    game.play_hand();
+
+                    const euchre_scoreboard &scoreboard = game.get_scoreboard();
+                    const int team1 = scoreboard.team1_score - scoreboard.team2_score;
+
+                    results[board * 2 + table] = (table == 0) ? team1 : -team1;
+                }
+            }
+        }
+
+        // play a duplicate tournament between contender a and contender b over the deals, sharded
+        // across worker threads. each deal is played with the teams swapped, so the luck of the
+        // cards cancels out of the paired result. the results do not depend on the number of
+        // threads.
+        static euchre_duplicate_result run_duplicate_tournament(const euchre_deal_log &deals,
+                                                                const uint64_t seed,
+                                                                const euchre_contender &a,
+                                                                const euchre_contender &b,
+                                                                const unsigned int num_threads = std::thread::hardware_concurrency())
+        {
+            const unsigned int workers = (num_threads == 0) ? 1 : num_threads;
+            const uint64_t num_boards = deals.size();
+
+            std::vector<int> results(num_boards * 2);
+            std::vector<std::thread> threads;
+            threads.reserve(workers);
+
+            const auto start = std::chrono::steady_clock::now();
+
+            for (unsigned int w = 0; w < workers; ++w)
+            {
+                // boards [first, last) belong to this worker
+                const uint64_t first = num_boards * w / workers;
+                const uint64_t last = num_boards * (w + 1) / workers;
+
+                threads.emplace_back([&deals, &a, &b, &results, first, last, seed]() {
+                    play_duplicate_boards(deals, first, last - first, seed, a, b, results);
+                });
+            }
+
+            for (auto &t : threads)
+                t.join();
+
+            const auto finish = std::chrono::steady_clock::now();
+
+            euchre_duplicate_result result;
+            result.boards = num_boards;
+            result.seconds = std::chrono::duration<double>(finish - start).count();
+
+            if (num_boards == 0)
+                return result;
+
+            // mean over boards of the mean of the two tables, and over single hands
+            double sum = 0.0f;
+            for (uint64_t board = 0; board < num_boards; ++board)
+            {
+                for (uint8_t table = 0; table < 2; ++table)
+                {
+                    const int points = results[board * 2 + table];
+
+                    sum += points;
+                    (points > 0 ? result.a_points : result.b_points) += std::abs(points);
+                }
+            }
+
+            result.mean = sum / (num_boards * 2);
+
+            double board_squares = 0.0f;
+            double hand_squares = 0.0f;
+            for (uint64_t board = 0; board < num_boards; ++board)
+            {
+                const double board_mean = (results[board * 2] + results[board * 2 + 1]) / 2.0f;
+                board_squares += (board_mean - result.mean) * (board_mean - result.mean);
+
+                for (uint8_t table = 0; table < 2; ++table)
+                    hand_squares += (results[board * 2 + table] - result.mean) * (results[board * 2 + table] - result.mean);
+            }
+
+            if (num_boards > 1)
+            {
+                result.std_error = std::sqrt(board_squares / (num_boards - 1) / num_boards);
+                result.unpaired_std_error = std::sqrt(hand_squares / (num_boards * 2 - 1) / (num_boards * 2));
+            }
+
+            return result;
+        }
+
+        // play a duplicate tournament between two ways of choosing cards to play, both scoring
+        // trump calls with the weights currently in use
+        static euchre_duplicate_result run_duplicate_tournament(const euchre_deal_log &deals,
+                                                                const uint64_t seed,
+                                                                const euchre_algo::pimc_settings &settings_a,
+                                                                const euchre_algo::pimc_settings &settings_b = euchre_algo::pimc_settings(),
+                                                                const unsigned int num_threads = std::thread::hardware_concurrency())
+        {
+            return run_duplicate_tournament(deals, seed, euchre_contender{settings_a, nullptr}, euchre_contender{settings_b, nullptr}, num_threads);
+        }
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
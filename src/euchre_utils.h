@@ -8,6 +8,8 @@
 
 #include <cstdint>
 
+#include "platform_defs.h"
+
 #include "euchre_card.h"
 #include "euchre_card_color.h"
 #include "euchre_card_rank.h"
@@ -16,6 +18,9 @@
 #include "euchre_perception.h"
 #include "euchre_seat_position.h"
 
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
 namespace rda
 {
     namespace euchre
@@ -84,3 +89,5 @@ namespace rda
     } // namespace euchre
 
 } // namespace rda
+
+POP_WARN_DISABLE
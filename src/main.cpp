@@ -5,20 +5,175 @@
 // Written by Ryan Antkowiak 
 //
 
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <thread>
 
+#include "euchre_deal_log.h"
 #include "euchre_game.h"
+#include "euchre_simulator.h"
+#include "euchre_tournament.h"
+#include "score_trump_call.h"
+#include "score_trump_call_tuner.h"
+#include "work_stealing_pool.h"
 
 #include "unit_tests/test_euchre.h"
 #include "unit_tests/test_euchre_algo_card_sorter.h"
+#include "unit_tests/test_euchre_algo_solver.h"
 
 // euchre program entry point
-int main()
+//
+// usage:
+//   euchre                   run unit tests
+//   euchre simulate <games> [threads] [seed] [samples] [time_limit_ms]
+//                            play games headless and report throughput. with
+//                            samples > 0, cards are chosen by sampling deals,
+//                            solved on the shared thread pool.
+//   euchre record <games> <file> [seed]
+//                            play games headless and save every deal to a file
+//   euchre replay <file> <games> [seed] [samples]
+//                            play games headless, dealing from a deal file
+//   euchre duplicate <boards> [threads] [seed] [samples_a] [samples_b]
+//                            play each random deal twice with the teams swapped,
+//                            and report how many more points per hand contender
+//                            a scores than contender b
+//   euchre tune <generations> <file> [boards] [population] [threads] [seed]
+//                            tune the trump call weights with a genetic algorithm,
+//                            playing each candidate against the weights in
+//                            euchre.json. progress is checkpointed to
+//                            <file>.checkpoint (and resumed from it), and the
+//                            best weights are written to <file>.
+int main(int argc, char *argv[])
 {
+    if (argc >= 2 && std::string(argv[1]) == "simulate")
+    {
+        const uint64_t num_games = (argc >= 3) ? std::strtoull(argv[2], nullptr, 10) : 1000;
+        const unsigned int num_threads = (argc >= 4) ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : std::thread::hardware_concurrency();
+        const uint64_t seed = (argc >= 5) ? std::strtoull(argv[4], nullptr, 10) : 0;
+
+        rda::euchre::euchre_algo::pimc_settings settings;
+        settings.num_samples = (argc >= 6) ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 0;
+        settings.time_limit_ms = (argc >= 7) ? static_cast<uint32_t>(std::strtoul(argv[6], nullptr, 10)) : 0;
+
+        if (settings.num_samples > 0)
+            settings.pool = &rda::work_stealing_pool::shared();
+
+        rda::euchre::score_trump_call::enable_table();
+
+        const rda::euchre::euchre_simulation_result result = rda::euchre::run_parallel_simulation(num_games, seed, num_threads, settings);
+        std::cout << result.to_string() << std::endl;
+
+        return 0;
+    }
+
+    if (argc >= 4 && std::string(argv[1]) == "record")
+    {
+        const uint64_t num_games = std::strtoull(argv[2], nullptr, 10);
+        const uint64_t seed = (argc >= 5) ? std::strtoull(argv[4], nullptr, 10) : 0;
+
+        rda::euchre::score_trump_call::enable_table();
+
+        rda::euchre::euchre_deal_log log;
+        const rda::euchre::euchre_simulation_result result = rda::euchre::record_games(num_games, seed, log);
+        std::cout << result.to_string() << std::endl;
+
+        if (!log.save(argv[3]))
+        {
+            std::cerr << "failed to write deal file: " << argv[3] << std::endl;
+            return 1;
+        }
+
+        std::cout << "deals: " << log.size() << std::endl;
+        return 0;
+    }
+
+    if (argc >= 4 && std::string(argv[1]) == "replay")
+    {
+        const uint64_t num_games = std::strtoull(argv[3], nullptr, 10);
+        const uint64_t seed = (argc >= 5) ? std::strtoull(argv[4], nullptr, 10) : 0;
+
+        rda::euchre::euchre_algo::pimc_settings settings;
+        settings.num_samples = (argc >= 6) ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 0;
+
+        if (settings.num_samples > 0)
+            settings.pool = &rda::work_stealing_pool::shared();
+
+        rda::euchre::euchre_deal_log log;
+        if (!log.load(argv[2]))
+        {
+            std::cerr << "failed to read deal file: " << argv[2] << std::endl;
+            return 1;
+        }
+
+        rda::euchre::score_trump_call::enable_table();
+
+        const rda::euchre::euchre_simulation_result result = rda::euchre::replay_games(num_games, seed, log, settings);
+        std::cout << result.to_string() << std::endl;
+
+        return 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "duplicate")
+    {
+        const uint64_t num_boards = std::strtoull(argv[2], nullptr, 10);
+        const unsigned int num_threads = (argc >= 4) ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : std::thread::hardware_concurrency();
+        const uint64_t seed = (argc >= 5) ? std::strtoull(argv[4], nullptr, 10) : 0;
+
+        rda::euchre::euchre_algo::pimc_settings settings_a, settings_b;
+        settings_a.num_samples = (argc >= 6) ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 0;
+        settings_b.num_samples = (argc >= 7) ? static_cast<uint32_t>(std::strtoul(argv[6], nullptr, 10)) : 0;
+
+        if (settings_a.num_samples > 0)
+            settings_a.pool = &rda::work_stealing_pool::shared();
+
+        if (settings_b.num_samples > 0)
+            settings_b.pool = &rda::work_stealing_pool::shared();
+
+        rda::euchre::score_trump_call::enable_table();
+
+        const rda::euchre::euchre_deal_log deals = rda::euchre::make_random_deals(num_boards, seed);
+        const rda::euchre::euchre_duplicate_result result = rda::euchre::run_duplicate_tournament(deals, seed, settings_a, settings_b, num_threads);
+        std::cout << result.to_string() << std::endl;
+
+        return 0;
+    }
+
+    if (argc >= 4 && std::string(argv[1]) == "tune")
+    {
+        rda::euchre::score_trump_call_tuner_settings settings;
+        settings.generations = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+        settings.checkpoint_path = std::string(argv[3]) + ".checkpoint";
+
+        if (argc >= 5)
+            settings.boards = std::strtoull(argv[4], nullptr, 10);
+
+        if (argc >= 6)
+            settings.population = static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10));
+
+        if (argc >= 7)
+            settings.num_threads = static_cast<unsigned int>(std::strtoul(argv[6], nullptr, 10));
+
+        if (argc >= 8)
+            settings.seed = std::strtoull(argv[7], nullptr, 10);
+
+        const rda::euchre::score_trump_call_tuner_state state = rda::euchre::score_trump_call_tuner::run(
+            *rda::euchre::score_trump_call_weights::current(), settings,
+            [](const rda::euchre::score_trump_call_tuner_state &s) { std::cout << s.to_string() << std::endl; });
+
+        if (!state.best.weights.save_file(argv[3]))
+        {
+            std::cerr << "failed to write weights file: " << argv[3] << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
     // run unit tests
     rda::test_euchre::run_tests();
     rda::test_euchre_algo_card_sorter::run_tests();
+    rda::test_euchre_algo_solver::run_tests();
 
     rda::euchre::euchre_game game;
     //game.play_game();
@@ -1,33 +1,160 @@
 #pragma once
 
 //
-// random_seeder.h - Seed a random engine with the time
+// random_seeder.h - Seedable, splittable random engine
 //
 // Written by Ryan Antkowiak 
 //
 
+#include <array>
 #include <chrono>
-#include <cstdlib>
-#include <ctime>
-#include <random>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "platform_defs.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
 
 namespace rda
 {
     namespace euchre
     {
-        // seed the random number generator (once)
-        static void seed_randomizer()
+        // xoshiro256** random engine. fast, with a period of 2^256 - 1, and splittable into
+        // independent streams. meets the requirements of a uniform random bit generator, so it
+        // can be used with std::shuffle and the std distributions.
+        class euchre_random_engine
         {
-            static bool seeded = false;
+        public:
+            typedef uint64_t result_type;
+
+        private:
+            // generator state (never all zero)
+            std::array<uint64_t, 4> state{};
+
+        public:
+            // constructor. engines with the same seed and stream produce the same sequence.
+            explicit euchre_random_engine(const uint64_t seed_value = 0, const uint64_t stream = 0)
+            {
+                seed(seed_value, stream);
+            }
+
+            // smallest value returned
+            static constexpr result_type min()
+            {
+                return 0;
+            }
+
+            // largest value returned
+            static constexpr result_type max()
+            {
+                return UINT64_MAX;
+            }
+
+            // reset the engine. different streams of the same seed give independent sequences.
+            void seed(const uint64_t seed_value, const uint64_t stream = 0)
+            {
+                uint64_t x = hash64(seed_value) ^ hash64(stream + 0x632BE59BD9B4E019ULL);
+
+                for (auto &s : state)
+                    s = splitmix64(x);
+            }
+
+            // return the next random value
+            result_type operator()()
+            {
+                const uint64_t result = rotl(state[1] * 5, 7) * 9;
+                const uint64_t t = state[1] << 17;
+
+                state[2] ^= state[0];
+                state[3] ^= state[1];
+                state[1] ^= state[2];
+                state[0] ^= state[3];
+                state[2] ^= t;
+                state[3] = rotl(state[3], 45);
+
+                return result;
+            }
+
+            // advance the engine by 2^128 values
+            void jump()
+            {
+                static const std::array<uint64_t, 4> JUMP = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                                             0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
 
-            // only seed the random engine once
-            if (!seeded)
+                std::array<uint64_t, 4> jumped{};
+
+                for (auto &j : JUMP)
+                {
+                    for (int b = 0; b < 64; ++b)
+                    {
+                        if (j & (uint64_t(1) << b))
+                            for (size_t i = 0; i < jumped.size(); ++i)
+                                jumped[i] ^= state[i];
+
+                        (*this)();
+                    }
+                }
+
+                state = jumped;
+            }
+
+            // return an engine for a new stream, and move this engine past it. the new engine
+            // produces 2^128 values before reaching values this engine will produce.
+            euchre_random_engine split()
+            {
+                euchre_random_engine child = *this;
+                jump();
+                return child;
+            }
+
+        private:
+            static uint64_t rotl(const uint64_t x, const int k)
+            {
+                return (x << k) | (x >> (64 - k));
+            }
+
+            // splitmix64 step, used to spread a seed over the state
+            static uint64_t splitmix64(uint64_t &x)
             {
-                std::srand(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-                seeded = true;
+                uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
             }
+
+            // hash a value with one splitmix64 step
+            static uint64_t hash64(uint64_t x)
+            {
+                return splitmix64(x);
+            }
+        };
+
+        // return a seed taken from the clock and the calling thread, for unrepeatable runs
+        static uint64_t make_random_seed()
+        {
+            return static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()) ^
+                   static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        }
+
+        // return the random engine for the calling thread, for code that is not given an engine
+        // (a game passes its own engines to the players and deck). seeded from the clock and
+        // thread id until seed_random_engine() is called.
+        static euchre_random_engine &get_random_engine()
+        {
+            thread_local euchre_random_engine engine(make_random_seed());
+            return engine;
+        }
+
+        // seed the random engine of the calling thread, for reproducible runs
+        static void seed_random_engine(const uint64_t seed, const uint64_t stream = 0)
+        {
+            get_random_engine().seed(seed, stream);
         }
 
     } // namespace euchre
 
 } // namespace rda
+
+POP_WARN_DISABLE
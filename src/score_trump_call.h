@@ -6,17 +6,31 @@
 // Written by Ryan Antkowiak 
 //
 
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
-#include "fileio.h"
-#include "json.h"
+#include "platform_defs.h"
 
 #include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_card_suit.h"
+#include "euchre_constants.h"
 #include "euchre_hand.h"
 #include "euchre_perception.h"
+#include "euchre_seat_position.h"
+#include "euchre_trump_decision.h"
 #include "euchre_utils.h"
+#include "score_trump_call_batch.h"
 #include "score_trump_call_context.h"
+#include "score_trump_call_features.h"
+#include "score_trump_call_table.h"
+#include "score_trump_call_weights.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
 
 namespace rda
 {
@@ -24,499 +38,186 @@ namespace rda
     {
         namespace score_trump_call
         {
-            // score having the right bower of trump
-            static double score_have_right_bower_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_right_bower_trump");
-                if (s != 0.0f)
-                    if (ctx.m_hand.contains(euchre_utils::right_bower(ctx.m_suit)))
-                        return s;
-                return 0.0f;
-            }
-
-            // score having the left bower of trump
-            static double score_have_left_bower_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_left_bower_trump");
-                if (s != 0.0f)
-                    if (ctx.m_hand.contains(euchre_utils::left_bower(ctx.m_suit)))
-                        return s;
-                return 0.0f;
-            }
-
-            // score having the ace of trump
-            static double score_have_ace_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_ace_trump");
-                if (s != 0.0f)
-                    if (ctx.m_hand.contains(euchre_card(ctx.m_suit, e_rank::ACE)))
-                        return s;
-                return 0.0f;
-            }
-
-            // score having the king of trump
-            static double score_have_king_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_king_trump");
-                if (s != 0.0f)
-                    if (ctx.m_hand.contains(euchre_card(ctx.m_suit, e_rank::KING)))
-                        return s;
-                return 0.0f;
-            }
-
-            // score having the queen of trump
-            static double score_have_queen_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_queen_trump");
-                if (s != 0.0f)
-                    if (ctx.m_hand.contains(euchre_card(ctx.m_suit, e_rank::QUEEN)))
-                        return s;
-                return 0.0f;
-            }
-
-            // score having the ten of trump
-            static double score_have_ten_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_ten_trump");
-                if (s != 0.0f)
-                    if (ctx.m_hand.contains(euchre_card(ctx.m_suit, e_rank::TEN)))
-                        return s;
-                return 0.0f;
-            }
-
-            // score having the nine of trump
-            static double score_have_nine_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_nine_trump");
-                if (s != 0.0f)
-                    if (ctx.m_hand.contains(euchre_card(ctx.m_suit, e_rank::NINE)))
-                        return s;
-                return 0.0f;
-            }
-
-            // score would pick up right bower trump
-            static double score_would_pick_up_right_bower_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/would_pick_up_right_bower_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::SELF &&
-                        ctx.m_up_card == euchre_utils::right_bower(ctx.m_suit))
-                        return s;
-                return 0.0f;
-            }
-
-            // score would pick up left bower trump
-            static double score_would_pick_up_left_bower_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/would_pick_up_left_bower_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::SELF &&
-                        ctx.m_up_card == euchre_utils::left_bower(ctx.m_suit))
-                        return s;
-                return 0.0f;
-            }
-
-            // score would pick up ace trump
-            static double score_would_pick_up_ace_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/would_pick_up_ace_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::SELF &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::ACE))
-                        return s;
-                return 0.0f;
-            }
-
-            // score would pick up king trump
-            static double score_would_pick_up_king_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/would_pick_up_king_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::SELF &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::KING))
-                        return s;
-                return 0.0f;
-            }
-
-            // score would pick up queen trump
-            static double score_would_pick_up_queen_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/would_pick_up_queen_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::SELF &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::QUEEN))
-                        return s;
-                return 0.0f;
-            }
-
-            // score would pick up ten trump
-            static double score_would_pick_up_ten_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/would_pick_up_ten_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::SELF &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::TEN))
-                        return s;
-                return 0.0f;
-            }
-
-            // score would pick up nine trump
-            static double score_would_pick_up_nine_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/would_pick_up_nine_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::SELF &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::NINE))
-                        return s;
-                return 0.0f;
-            }
-
-            // score partner would pick up right bower trump
-            static double score_partner_would_pick_up_right_bower_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_would_pick_up_right_bower_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::ACROSS &&
-                        ctx.m_up_card == euchre_utils::right_bower(ctx.m_suit))
-                        return s;
-                return 0.0f;
-            }
-
-            // score partner would pick up left bower trump
-            static double score_partner_would_pick_up_left_bower_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_would_pick_up_left_bower_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::ACROSS &&
-                        ctx.m_up_card == euchre_utils::left_bower(ctx.m_suit))
-                        return s;
-                return 0.0f;
-            }
-
-            // score partner would pick up ace trump
-            static double score_partner_would_pick_up_ace_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_would_pick_up_ace_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::ACROSS &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::ACE))
-                        return s;
-                return 0.0f;
-            }
-
-            // score partner would pick up king trump
-            static double score_partner_would_pick_up_king_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_would_pick_up_king_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::ACROSS &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::KING))
-                        return s;
-                return 0.0f;
-            }
-
-            // score partner would pick up queen trump
-            static double score_partner_would_pick_up_queen_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_would_pick_up_queen_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::ACROSS &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::QUEEN))
-                        return s;
-                return 0.0f;
-            }
-
-            // score partner would pick up ten trump
-            static double score_partner_would_pick_up_ten_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_would_pick_up_ten_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::ACROSS &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::TEN))
-                        return s;
-                return 0.0f;
-            }
-
-            // score partner would pick up nine trump
-            static double score_partner_would_pick_up_nine_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_would_pick_up_nine_trump");
-                if (s != 0.0f)
-                    if (ctx.m_dealer_seat_position == euchre_seat_position::ACROSS &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::NINE))
-                        return s;
-                return 0.0f;
-            }
-
-            // score opponent would pick up right bower trump
-            static double score_opponent_would_pick_up_right_bower_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/opponent_would_pick_up_right_bower_trump");
-                if (s != 0.0f)
-                    if ((ctx.m_dealer_seat_position == euchre_seat_position::LEFT || ctx.m_dealer_seat_position == euchre_seat_position::RIGHT) &&
-                        ctx.m_up_card == euchre_utils::right_bower(ctx.m_suit))
-                        return s;
-                return 0.0f;
-            }
-
-            // score opponent would pick up left bower trump
-            static double score_opponent_would_pick_up_left_bower_trump(const score_trump_call_context &ctx)
+            // score the terms that depend only on the cards in the hand (and the trump suit).
+            // with the up-card turned down, the non-trump winner count also depends on the up-card.
+            static double score_hand_terms(const score_trump_call_context &ctx)
             {
-                const double s = ctx.get_score_value("trump_call/opponent_would_pick_up_left_bower_trump");
-                if (s != 0.0f)
-                    if ((ctx.m_dealer_seat_position == euchre_seat_position::LEFT || ctx.m_dealer_seat_position == euchre_seat_position::RIGHT) &&
-                        ctx.m_up_card == euchre_utils::left_bower(ctx.m_suit))
-                        return s;
-                return 0.0f;
+                return dot(extract_features(ctx), ctx.get_weights(), e_trump_call_terms::HAND);
             }
 
-            // score opponent would pick up ace trump
-            static double score_opponent_would_pick_up_ace_trump(const score_trump_call_context &ctx)
+            // returns true if the hand terms of a context can be read from the table
+            static bool can_use_table(const score_trump_call_context &ctx, const score_trump_call_table &table)
             {
-                const double s = ctx.get_score_value("trump_call/opponent_would_pick_up_ace_trump");
-                if (s != 0.0f)
-                    if ((ctx.m_dealer_seat_position == euchre_seat_position::LEFT || ctx.m_dealer_seat_position == euchre_seat_position::RIGHT) &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::ACE))
-                        return s;
-                return 0.0f;
+                return table.weights().get() == &ctx.get_weights() &&
+                       ctx.get_hand_size() == euchre_constants::EUCHRE_HAND_SIZE &&
+                       !ctx.m_up_card_was_turned_down &&
+                       ctx.m_suit < e_suit::END;
             }
 
-            // score opponent would pick up king trump
-            static double score_opponent_would_pick_up_king_trump(const score_trump_call_context &ctx)
+            // score the calling of a trump suit with the given weights, given the provided game
+            // state. the context refers to the weights, so they must outlive it.
+            static score_trump_call_context score(const std::shared_ptr<const score_trump_call_weights> &weights,
+                                                  const e_suit suit,
+                                                  const euchre_hand &hand,
+                                                  const euchre_card &up_card,
+                                                  const bool up_card_was_turned_down,
+                                                  const euchre_seat_position dealer_seat_position,
+                                                  const euchre_perception &left_perception,
+                                                  const euchre_perception &partner_perception,
+                                                  const euchre_perception &right_perception)
             {
-                const double s = ctx.get_score_value("trump_call/opponent_would_pick_up_king_trump");
-                if (s != 0.0f)
-                    if ((ctx.m_dealer_seat_position == euchre_seat_position::LEFT || ctx.m_dealer_seat_position == euchre_seat_position::RIGHT) &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::KING))
-                        return s;
-                return 0.0f;
-            }
+                score_trump_call_context ctx(*weights,
+                                             suit,
+                                             hand,
+                                             up_card,
+                                             up_card_was_turned_down,
+                                             dealer_seat_position,
+                                             left_perception,
+                                             partner_perception,
+                                             right_perception);
 
-            // score opponent would pick up queen trump
-            static double score_opponent_would_pick_up_queen_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/opponent_would_pick_up_queen_trump");
-                if (s != 0.0f)
-                    if ((ctx.m_dealer_seat_position == euchre_seat_position::LEFT || ctx.m_dealer_seat_position == euchre_seat_position::RIGHT) &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::QUEEN))
-                        return s;
-                return 0.0f;
-            }
+                const score_trump_call_inputs in = get_inputs(ctx);
 
-            // score opponent would pick up ten trump
-            static double score_opponent_would_pick_up_ten_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/opponent_would_pick_up_ten_trump");
-                if (s != 0.0f)
-                    if ((ctx.m_dealer_seat_position == euchre_seat_position::LEFT || ctx.m_dealer_seat_position == euchre_seat_position::RIGHT) &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::TEN))
-                        return s;
-                return 0.0f;
-            }
+                // use the precomputed hand terms if a table is enabled for these weights
+                const auto table = score_trump_call_table::current();
 
-            // score opponent would pick up nine trump
-            static double score_opponent_would_pick_up_nine_trump(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/opponent_would_pick_up_nine_trump");
-                if (s != 0.0f)
-                    if ((ctx.m_dealer_seat_position == euchre_seat_position::LEFT || ctx.m_dealer_seat_position == euchre_seat_position::RIGHT) &&
-                        ctx.m_up_card == euchre_card(ctx.m_suit, e_rank::NINE))
-                        return s;
-                return 0.0f;
-            }
+                const double hand_total = (table != nullptr && can_use_table(ctx, *table))
+                                              ? table->lookup(ctx.m_hand, suit)
+                                              : dot(in, *weights, e_trump_call_terms::HAND);
 
-            // score having one suit
-            static double score_have_one_suited(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_one_suited");
-                if (s != 0.0f)
-                    if (ctx.m_num_suits == 1)
-                        return s;
-                return 0.0f;
-            }
+                ctx.set_total_score(hand_total + dot(in, *weights, e_trump_call_terms::SITUATION));
 
-            // score having two suits
-            static double score_have_two_suited(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_two_suited");
-                if (s != 0.0f)
-                    if (ctx.m_num_suits == 2)
-                        return s;
-                return 0.0f;
+                return ctx;
             }
 
-            // score having three suits
-            static double score_have_three_suited(const score_trump_call_context &ctx)
+            // the score of calling each trump suit, indexed by e_suit
+            typedef std::array<double, euchre_constants::NUM_SUITS> suit_scores;
+
+            // score the calling of every trump suit with the given weights, given the provided game
+            // state. the hand is scanned once for all four suits, and no context is built, so this
+            // is cheaper than four calls to score(). each score is identical to that of score().
+            static suit_scores score_suits(const std::shared_ptr<const score_trump_call_weights> &weights,
+                                           const euchre_hand &hand,
+                                           const euchre_card &up_card,
+                                           const bool up_card_was_turned_down,
+                                           const euchre_seat_position dealer_seat_position,
+                                           const euchre_perception &left_perception,
+                                           const euchre_perception &partner_perception,
+                                           const euchre_perception &right_perception)
+            {
+                score_trump_call_inputs in;
+                in.hand = hand.mask();
+                in.up_card = up_card;
+                in.up_card_was_turned_down = up_card_was_turned_down;
+                in.dealer_seat_position = dealer_seat_position;
+                in.partner_passed_on_up_card = partner_perception.up_card_offer_decision == e_trump_decision::PASS;
+                in.num_suits = euchre_mask::count_suits(in.hand);
+                in.num_opponents_passed_on_up_card = score_trump_call_context::count_opponents_passed_on_up_card(left_perception, right_perception);
+
+                // the up-card only counts as played out of the suit if it was turned down
+                const euchre_card_mask turned_down = up_card_was_turned_down ? euchre_mask::card_bit(up_card) : euchre_mask::EMPTY;
+
+                // winners in each suit. the non-trump winners are those of the other three suits.
+                std::array<uint8_t, euchre_constants::NUM_SUITS> winners{};
+                uint8_t total_winners = 0;
+
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                {
+                    winners[static_cast<size_t>(s)] = score_trump_call_context::count_suit_winners(in.hand, s, turned_down);
+                    total_winners += winners[static_cast<size_t>(s)];
+                }
+
+                // use the precomputed hand terms if a table is enabled for these weights
+                const auto table = score_trump_call_table::current();
+                const bool use_table = table != nullptr &&
+                                       table->weights() == weights &&
+                                       hand.size() == euchre_constants::EUCHRE_HAND_SIZE &&
+                                       !up_card_was_turned_down;
+
+                suit_scores scores{};
+
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                {
+                    in.suit = s;
+                    in.num_non_trump_winners = total_winners - winners[static_cast<size_t>(s)];
+
+                    const double hand_total = use_table ? table->lookup(in.hand, s)
+                                                        : dot(in, *weights, e_trump_call_terms::HAND);
+
+                    scores[static_cast<size_t>(s)] = hand_total + dot(in, *weights, e_trump_call_terms::SITUATION);
+                }
+
+                return scores;
+            }
+
+            // score the calling of a trump suit with the current weights, given the provided game
+            // state. the current weights must not be replaced while the context is used.
+            static score_trump_call_context score(const e_suit suit,
+                                                  const euchre_hand &hand,
+                                                  const euchre_card &up_card,
+                                                  const bool up_card_was_turned_down,
+                                                  const euchre_seat_position dealer_seat_position,
+                                                  const euchre_perception &left_perception,
+                                                  const euchre_perception &partner_perception,
+                                                  const euchre_perception &right_perception)
             {
-                const double s = ctx.get_score_value("trump_call/have_three_suited");
-                if (s != 0.0f)
-                    if (ctx.m_num_suits == 3)
-                        return s;
-                return 0.0f;
+                return score(score_trump_call_weights::current(),
+                             suit,
+                             hand,
+                             up_card,
+                             up_card_was_turned_down,
+                             dealer_seat_position,
+                             left_perception,
+                             partner_perception,
+                             right_perception);
             }
 
-            // score having four suits
-            static double score_have_four_suited(const score_trump_call_context &ctx)
+            // compute the table of hand terms for every five card hand, with the given weights
+            static std::shared_ptr<score_trump_call_table> build_table(const std::shared_ptr<const score_trump_call_weights> &weights)
             {
-                const double s = ctx.get_score_value("trump_call/have_four_suited");
-                if (s != 0.0f)
-                    if (ctx.m_num_suits == 4)
-                        return s;
-                return 0.0f;
-            }
+                auto table = std::make_shared<score_trump_call_table>(weights);
 
-            // score having four non trump winners
-            static double score_have_four_non_trump_winners(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_four_non_trump_winners");
-                if (s != 0.0f)
-                    if (ctx.m_num_non_trump_winners == 4)
-                        return s;
-                return 0.0f;
-            }
+                // every hand, in canonical order
+                std::vector<euchre_card_mask> hands;
+                hands.reserve(score_trump_call_table::NUM_HANDS);
 
-            // score having three non trump winners
-            static double score_have_three_non_trump_winners(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_three_non_trump_winners");
-                if (s != 0.0f)
-                    if (ctx.m_num_non_trump_winners == 3)
-                        return s;
-                return 0.0f;
-            }
+                for (euchre_card_mask m = score_trump_call_table::first_hand(); m <= euchre_mask::FULL_DECK; m = score_trump_call_table::next_hand(m))
+                    hands.push_back(m);
 
-            // score having two non trump winners
-            static double score_have_two_non_trump_winners(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_two_non_trump_winners");
-                if (s != 0.0f)
-                    if (ctx.m_num_non_trump_winners == 2)
-                        return s;
-                return 0.0f;
-            }
+                std::vector<double> scores(hands.size());
 
-            // score having one non trump winners
-            static double score_have_one_non_trump_winners(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_one_non_trump_winners");
-                if (s != 0.0f)
-                    if (ctx.m_num_non_trump_winners == 1)
-                        return s;
-                return 0.0f;
-            }
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                {
+                    score_hand_terms_batch(*weights, s, hands.data(), hands.size(), scores.data());
 
-            // score having zero non trump winners
-            static double score_have_zero_non_trump_winners(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/have_zero_non_trump_winners");
-                if (s != 0.0f)
-                    if (ctx.m_num_non_trump_winners == 0)
-                        return s;
-                return 0.0f;
-            }
+                    for (size_t i = 0; i < hands.size(); ++i)
+                        table->set(hands[i], s, scores[i]);
+                }
 
-            // score partner passed on up card
-            static double score_partner_passed_on_up_card(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/partner_passed_on_up_card");
-                if (s != 0.0f)
-                    if (ctx.m_up_card_was_turned_down == false &&
-                        ctx.m_suit == ctx.m_up_card.suit() &&
-                        ctx.m_partner_perception.up_card_offer_decision == e_trump_decision::PASS)
-                        return s;
-                return 0.0f;
+                return table;
             }
 
-            // score one opponent passed on up card
-            static double score_one_opponent_passed_on_up_card(const score_trump_call_context &ctx)
+            // enable the table of hand terms for the current weights. the table is read from
+            // "path" if it was saved for the same weights, otherwise it is built (and saved,
+            // if a path is given).
+            static void enable_table(const std::string &path = "")
             {
-                const double s = ctx.get_score_value("trump_call/one_opponent_passed_on_up_card");
-                if (s != 0.0f)
-                    if (ctx.m_up_card_was_turned_down == false &&
-                        ctx.m_suit == ctx.m_up_card.suit() &&
-                        ctx.m_num_opponents_passed_on_up_card == 1)
-                        return s;
-                return 0.0f;
-            }
+                const auto weights = score_trump_call_weights::current();
 
-            // score two opponents passed on up card
-            static double score_two_opponents_passed_on_up_card(const score_trump_call_context &ctx)
-            {
-                const double s = ctx.get_score_value("trump_call/two_opponents_passed_on_up_card");
-                if (s != 0.0f)
-                    if (ctx.m_up_card_was_turned_down == false &&
-                        ctx.m_suit == ctx.m_up_card.suit() &&
-                        ctx.m_num_opponents_passed_on_up_card == 2)
-                        return s;
-                return 0.0f;
-            }
+                std::shared_ptr<score_trump_call_table> table;
 
-            // score the calling of a trump suit, given the provided game state
-            static score_trump_call_context score(const e_suit suit,
-                                                  const euchre_hand &hand,
-                                                  const euchre_card &up_card,
-                                                  const bool up_card_was_turned_down,
-                                                  const euchre_seat_position dealer_seat_position,
-                                                  const euchre_perception &left_perception,
-                                                  const euchre_perception &partner_perception,
-                                                  const euchre_perception &right_perception)
-            {
-                rda::fileio f("euchre.json");
-                f.read();
+                if (!path.empty())
+                    table = score_trump_call_table::load(path, weights);
 
-                score_trump_call_context ctx(suit,
-                                             hand,
-                                             up_card,
-                                             up_card_was_turned_down,
-                                             dealer_seat_position,
-                                             left_perception,
-                                             partner_perception,
-                                             right_perception);
+                if (table == nullptr)
+                {
+                    table = build_table(weights);
 
-                double total = 0.0f;
-                total += score_have_right_bower_trump(ctx);
-                total += score_have_left_bower_trump(ctx);
-                total += score_have_ace_trump(ctx);
-                total += score_have_king_trump(ctx);
-                total += score_have_queen_trump(ctx);
-                total += score_have_ten_trump(ctx);
-                total += score_have_nine_trump(ctx);
-                total += score_would_pick_up_right_bower_trump(ctx);
-                total += score_would_pick_up_left_bower_trump(ctx);
-                total += score_would_pick_up_ace_trump(ctx);
-                total += score_would_pick_up_king_trump(ctx);
-                total += score_would_pick_up_queen_trump(ctx);
-                total += score_would_pick_up_ten_trump(ctx);
-                total += score_would_pick_up_nine_trump(ctx);
-                total += score_partner_would_pick_up_right_bower_trump(ctx);
-                total += score_partner_would_pick_up_left_bower_trump(ctx);
-                total += score_partner_would_pick_up_ace_trump(ctx);
-                total += score_partner_would_pick_up_king_trump(ctx);
-                total += score_partner_would_pick_up_queen_trump(ctx);
-                total += score_partner_would_pick_up_ten_trump(ctx);
-                total += score_partner_would_pick_up_nine_trump(ctx);
-                total += score_opponent_would_pick_up_right_bower_trump(ctx);
-                total += score_opponent_would_pick_up_left_bower_trump(ctx);
-                total += score_opponent_would_pick_up_ace_trump(ctx);
-                total += score_opponent_would_pick_up_king_trump(ctx);
-                total += score_opponent_would_pick_up_queen_trump(ctx);
-                total += score_opponent_would_pick_up_ten_trump(ctx);
-                total += score_opponent_would_pick_up_nine_trump(ctx);
-                total += score_have_one_suited(ctx);
-                total += score_have_two_suited(ctx);
-                total += score_have_three_suited(ctx);
-                total += score_have_four_suited(ctx);
-                total += score_have_four_non_trump_winners(ctx);
-                total += score_have_three_non_trump_winners(ctx);
-                total += score_have_two_non_trump_winners(ctx);
-                total += score_have_one_non_trump_winners(ctx);
-                total += score_have_zero_non_trump_winners(ctx);
-                total += score_partner_passed_on_up_card(ctx);
-                total += score_one_opponent_passed_on_up_card(ctx);
-                total += score_two_opponents_passed_on_up_card(ctx);
-                ctx.set_total_score(total);
+                    if (!path.empty())
+                        table->save(path);
+                }
 
-                return ctx;
+                score_trump_call_table::set_current(table);
             }
 
         } // namespace score_trump_call
@@ -524,3 +225,5 @@ namespace rda
     } // namespace euchre
 
 } // namespace rda
+
+POP_WARN_DISABLE
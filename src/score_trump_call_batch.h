@@ -0,0 +1,194 @@
+#pragma once
+
+//
+// score_trump_call_batch.h - Hand-only trump call scores for many hands at once
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_card_rank.h"
+#include "euchre_card_suit.h"
+#include "euchre_constants.h"
+#include "score_trump_call_weights.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        namespace score_trump_call
+        {
+            // count the aces in a mask without a popcount instruction, so the count vectorizes
+            static uint32_t count_aces(const euchre_card_mask mask)
+            {
+                const uint32_t ace = static_cast<uint32_t>(e_rank::ACE) - static_cast<uint32_t>(e_rank::BEGIN);
+
+                return ((mask >> ace) & 1) +
+                       ((mask >> (ace + euchre_constants::NUM_RANKS)) & 1) +
+                       ((mask >> (ace + 2 * euchre_constants::NUM_RANKS)) & 1) +
+                       ((mask >> (ace + 3 * euchre_constants::NUM_RANKS)) & 1);
+            }
+
+            // score the hand terms (see score_hand_terms) of "count" hands for one trump suit, with
+            // the up-card not turned down, into out[0 .. count). the loop has no branches and
+            // reads and writes flat arrays, so the compiler can vectorize it. the terms are added
+            // in the same order as score_hand_terms, so with doubles the totals are identical.
+            template <typename value_type>
+            static void score_hand_terms_batch(const score_trump_call_weights &weights,
+                                               const e_suit trump,
+                                               const euchre_card_mask *hands,
+                                               const size_t count,
+                                               value_type *out)
+            {
+                // bit index of each trump card that is scored
+                const uint32_t right = euchre_mask::card_index(euchre_card(trump, e_rank::JACK));
+                const uint32_t left = euchre_mask::card_index(euchre_card(euchre_mask::same_color_suit(trump), e_rank::JACK));
+                const uint32_t ace = euchre_mask::card_index(euchre_card(trump, e_rank::ACE));
+                const uint32_t king = euchre_mask::card_index(euchre_card(trump, e_rank::KING));
+                const uint32_t queen = euchre_mask::card_index(euchre_card(trump, e_rank::QUEEN));
+                const uint32_t ten = euchre_mask::card_index(euchre_card(trump, e_rank::TEN));
+                const uint32_t nine = euchre_mask::card_index(euchre_card(trump, e_rank::NINE));
+
+                // the aces of the three other suits (each king is the bit below its ace)
+                const euchre_card_mask off_aces = euchre_mask::rank_mask(e_rank::ACE) & ~euchre_mask::suit_mask(trump);
+
+                const auto w = [&](const e_trump_call_term term) { return static_cast<value_type>(weights.get(term)); };
+
+                const value_type w_right = w(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP);
+                const value_type w_left = w(e_trump_call_term::HAVE_LEFT_BOWER_TRUMP);
+                const value_type w_ace = w(e_trump_call_term::HAVE_ACE_TRUMP);
+                const value_type w_king = w(e_trump_call_term::HAVE_KING_TRUMP);
+                const value_type w_queen = w(e_trump_call_term::HAVE_QUEEN_TRUMP);
+                const value_type w_ten = w(e_trump_call_term::HAVE_TEN_TRUMP);
+                const value_type w_nine = w(e_trump_call_term::HAVE_NINE_TRUMP);
+                const value_type w_one_suited = w(e_trump_call_term::HAVE_ONE_SUITED);
+                const value_type w_two_suited = w(e_trump_call_term::HAVE_TWO_SUITED);
+                const value_type w_three_suited = w(e_trump_call_term::HAVE_THREE_SUITED);
+                const value_type w_four_suited = w(e_trump_call_term::HAVE_FOUR_SUITED);
+                const value_type w_four_winners = w(e_trump_call_term::HAVE_FOUR_NON_TRUMP_WINNERS);
+                const value_type w_three_winners = w(e_trump_call_term::HAVE_THREE_NON_TRUMP_WINNERS);
+                const value_type w_two_winners = w(e_trump_call_term::HAVE_TWO_NON_TRUMP_WINNERS);
+                const value_type w_one_winner = w(e_trump_call_term::HAVE_ONE_NON_TRUMP_WINNERS);
+                const value_type w_zero_winners = w(e_trump_call_term::HAVE_ZERO_NON_TRUMP_WINNERS);
+
+                const euchre_card_mask s0 = euchre_mask::SUIT_BITS;
+                const euchre_card_mask s1 = euchre_mask::SUIT_BITS << euchre_constants::NUM_RANKS;
+                const euchre_card_mask s2 = euchre_mask::SUIT_BITS << (2 * euchre_constants::NUM_RANKS);
+                const euchre_card_mask s3 = euchre_mask::SUIT_BITS << (3 * euchre_constants::NUM_RANKS);
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const euchre_card_mask h = hands[i];
+
+                    // number of printed suits held
+                    const uint32_t suits = static_cast<uint32_t>((h & s0) != 0) + static_cast<uint32_t>((h & s1) != 0) +
+                                           static_cast<uint32_t>((h & s2) != 0) + static_cast<uint32_t>((h & s3) != 0);
+
+                    // an off-suit ace is one winner, and two with the king of its suit
+                    const euchre_card_mask aces = h & off_aces;
+                    const uint32_t winners = count_aces(aces) + count_aces(aces & (h << 1));
+
+                    value_type total = 0;
+                    total += w_right * static_cast<value_type>((h >> right) & 1);
+                    total += w_left * static_cast<value_type>((h >> left) & 1);
+                    total += w_ace * static_cast<value_type>((h >> ace) & 1);
+                    total += w_king * static_cast<value_type>((h >> king) & 1);
+                    total += w_queen * static_cast<value_type>((h >> queen) & 1);
+                    total += w_ten * static_cast<value_type>((h >> ten) & 1);
+                    total += w_nine * static_cast<value_type>((h >> nine) & 1);
+                    total += w_one_suited * static_cast<value_type>(suits == 1);
+                    total += w_two_suited * static_cast<value_type>(suits == 2);
+                    total += w_three_suited * static_cast<value_type>(suits == 3);
+                    total += w_four_suited * static_cast<value_type>(suits == 4);
+                    total += w_four_winners * static_cast<value_type>(winners == 4);
+                    total += w_three_winners * static_cast<value_type>(winners == 3);
+                    total += w_two_winners * static_cast<value_type>(winners == 2);
+                    total += w_one_winner * static_cast<value_type>(winners == 1);
+                    total += w_zero_winners * static_cast<value_type>(winners == 0);
+
+                    out[i] = total;
+                }
+            }
+
+        } // namespace score_trump_call
+
+        // a batch of hands, stored as one array of card masks, and their hand-only trump call
+        // scores, stored as one array per trump suit
+        class score_trump_call_batch
+        {
+        private:
+            // the hands
+            std::vector<euchre_card_mask> m_hands;
+
+            // the score of every hand, for each trump suit
+            std::array<std::vector<float>, euchre_constants::NUM_SUITS> m_scores;
+
+        public:
+            // add a hand to the batch
+            void add(const euchre_card_mask hand)
+            {
+                m_hands.push_back(hand);
+            }
+
+            // remove every hand
+            void clear()
+            {
+                m_hands.clear();
+
+                for (auto &s : m_scores)
+                    s.clear();
+            }
+
+            // return the number of hands
+            size_t size() const
+            {
+                return m_hands.size();
+            }
+
+            // return the hands
+            const std::vector<euchre_card_mask> &hands() const
+            {
+                return m_hands;
+            }
+
+            // score every hand for every trump suit
+            void score(const score_trump_call_weights &weights)
+            {
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                {
+                    std::vector<float> &scores = m_scores[static_cast<size_t>(s)];
+                    scores.resize(m_hands.size());
+
+                    score_trump_call::score_hand_terms_batch(weights, s, m_hands.data(), m_hands.size(), scores.data());
+                }
+            }
+
+            // return the scores of every hand for a trump suit (after score())
+            const std::vector<float> &scores(const e_suit trump) const
+            {
+                return m_scores[static_cast<size_t>(trump)];
+            }
+
+            // return the score of hand i for a trump suit (after score())
+            float get(const size_t i, const e_suit trump) const
+            {
+                return m_scores[static_cast<size_t>(trump)][i];
+            }
+        };
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
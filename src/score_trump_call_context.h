@@ -6,38 +6,37 @@
 // Written by Ryan Antkowiak 
 //
 
-#include <array>
-#include <memory>
-#include <numeric>
-
-#include "fileio.h"
-#include "json.h"
+#include <cstdint>
+#include <type_traits>
 
 #include "euchre_card.h"
+#include "euchre_card_mask.h"
 #include "euchre_card_rank.h"
 #include "euchre_card_suit.h"
 #include "euchre_hand.h"
 #include "euchre_perception.h"
 #include "euchre_seat_position.h"
 #include "euchre_trump_decision.h"
+#include "score_trump_call_weights.h"
 
 namespace rda
 {
     namespace euchre
     {
-        // the context of the game for scoring a particular trump suit
+        // the context of the game for scoring a particular trump suit. the context is a compact
+        // snapshot of the game state (the hand as a card mask, and only the decisions of the
+        // perceptions that are scored), so it is trivially copyable and never allocates. it
+        // refers to the weights without owning them; they must outlive the context.
         class score_trump_call_context
         {
         public:
             // input values
             const e_suit m_suit;
-            const euchre_hand m_hand;
+            const euchre_card_mask m_hand;
             const euchre_card m_up_card;
             const bool m_up_card_was_turned_down;
             const euchre_seat_position m_dealer_seat_position;
-            const euchre_perception m_left_perception;
-            const euchre_perception m_partner_perception;
-            const euchre_perception m_right_perception;
+            const bool m_partner_passed_on_up_card;
 
             // calculated values
             const uint8_t m_num_suits;
@@ -45,14 +44,16 @@ namespace rda
             const uint8_t m_num_opponents_passed_on_up_card;
 
         private:
+            // the weights used for scoring
+            const score_trump_call_weights *const m_weights;
+
             // score
             double m_total_score = 0.0f;
-            double m_trump_call_threshold = 0.0f;
-            double m_loner_call_threshhold = 0.0f;
 
         public:
             // constructor
-            score_trump_call_context(const e_suit suit,
+            score_trump_call_context(const score_trump_call_weights &weights,
+                                     const e_suit suit,
                                      const euchre_hand &hand,
                                      const euchre_card &up_card,
                                      const bool up_card_was_turned_down,
@@ -61,25 +62,34 @@ namespace rda
                                      const euchre_perception &partner_perception,
                                      const euchre_perception &right_perception)
                 : m_suit(suit),
-                  m_hand(hand),
+                  m_hand(hand.mask()),
                   m_up_card(up_card),
                   m_up_card_was_turned_down(up_card_was_turned_down),
                   m_dealer_seat_position(dealer_seat_position),
-                  m_left_perception(left_perception),
-                  m_partner_perception(partner_perception),
-                  m_right_perception(right_perception),
+                  m_partner_passed_on_up_card(partner_perception.up_card_offer_decision == e_trump_decision::PASS),
                   m_num_suits(count_num_suits()),
                   m_num_non_trump_winners(count_num_non_trump_winners()),
-                  m_num_opponents_passed_on_up_card(count_num_opponents_passed_on_up_card())
+                  m_num_opponents_passed_on_up_card(count_opponents_passed_on_up_card(left_perception, right_perception)),
+                  m_weights(&weights)
+            {
+            }
+
+            // return the weight of a scoring term
+            double get_score_value(const e_trump_call_term term) const
             {
-                m_trump_call_threshold = get_json_file_data()->get_float_by_path("trump_call/trump_call_threshold");
-                m_loner_call_threshhold = get_json_file_data()->get_float_by_path("trump_call/loner_call_threshold");
+                return m_weights->get(term);
             }
 
-            // return the value of a score for given key
-            double get_score_value(const std::string &score_key) const
+            // return the weights used for scoring
+            const score_trump_call_weights &get_weights() const
             {
-                return get_json_file_data()->get_float_by_path(score_key);
+                return *m_weights;
+            }
+
+            // return the number of cards in the hand
+            uint8_t get_hand_size() const
+            {
+                return euchre_mask::popcount(m_hand);
             }
 
             // set the score of this context
@@ -97,42 +107,56 @@ namespace rda
             // return the score required to call trump
             double get_trump_call_threshold() const
             {
-                return m_trump_call_threshold;
+                return m_weights->get(e_trump_call_term::TRUMP_CALL_THRESHOLD);
             }
 
             // return the score required to call a loner
             double get_loner_call_threshold() const
             {
-                return m_loner_call_threshhold;
+                return m_weights->get(e_trump_call_term::LONER_CALL_THRESHOLD);
             }
 
-        private:
-            // keep a singleton static instance of json file data
-            static std::shared_ptr<rda::json::node_object> get_json_file_data()
+            // count the "winning" cards of one non-trump suit in a hand: an ACE, or a KING with
+            // the ACE turned down, is one winner, and two with the next card down
+            static uint8_t count_suit_winners(const euchre_card_mask hand, const e_suit s, const euchre_card_mask turned_down)
             {
-                static std::shared_ptr<rda::json::node_object> file_data = nullptr;
+                const euchre_card_mask ace = euchre_mask::card_bit(euchre_card(s, e_rank::ACE));
+                const euchre_card_mask king = euchre_mask::card_bit(euchre_card(s, e_rank::KING));
+                const euchre_card_mask queen = euchre_mask::card_bit(euchre_card(s, e_rank::QUEEN));
+
+                // ACE and KING suited, or KING and QUEEN with the ACE turned down, or ACE and QUEEN with the KING turned down: 2 winners
+                if (euchre_mask::contains_all(hand, ace | king) ||
+                    (turned_down == ace && euchre_mask::contains_all(hand, king | queen)) ||
+                    (turned_down == king && euchre_mask::contains_all(hand, ace | queen)))
+                    return 2;
 
-                if (file_data == nullptr)
-                {
-                    rda::fileio f("euchre.json");
-                    f.read();
-                    file_data = rda::json::parse(f.to_string());
-                }
+                // ACE, or KING with the ACE turned down: 1 winner
+                if ((hand & ace) || (turned_down == ace && (hand & king)))
+                    return 1;
 
-                return file_data;
+                return 0;
             }
 
-            // count the number of suits in a hand
-            uint8_t count_num_suits() const
+            // count the number of opponents who passed on the up-card
+            static uint8_t count_opponents_passed_on_up_card(const euchre_perception &left_perception,
+                                                             const euchre_perception &right_perception)
             {
-                std::array<uint8_t, static_cast<size_t>(e_suit::END)> suits{};
+                uint8_t opponents = 0;
 
-                std::for_each(m_hand.cbegin(), m_hand.cend(),
-                              [&](const auto &card) {
-                                  suits[static_cast<size_t>(card.suit())] = 1;
-                              });
+                if (left_perception.up_card_offer_decision == e_trump_decision::PASS)
+                    ++opponents;
 
-                return std::accumulate(suits.begin(), suits.end(), 0);
+                if (right_perception.up_card_offer_decision == e_trump_decision::PASS)
+                    ++opponents;
+
+                return opponents;
+            }
+
+        private:
+            // count the number of suits in a hand
+            uint8_t count_num_suits() const
+            {
+                return euchre_mask::count_suits(m_hand);
             }
 
             // count the number of non-trump "winning" cards in a hand
@@ -140,74 +164,21 @@ namespace rda
             {
                 uint8_t winners = 0;
 
-                // iterate through suits
+                // the up-card only counts as played out of the suit if it was turned down
+                const euchre_card_mask turned_down = m_up_card_was_turned_down ? euchre_mask::card_bit(m_up_card) : euchre_mask::EMPTY;
+
+                // iterate through suits that aren't being considered for trump
                 for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
-                {
-                    // for any suit that isn't being considered for trump
                     if (s != m_suit)
-                    {
-                        // check if contains ACE and KING suited, 2 winners
-                        if (m_hand.contains({euchre_card(s, e_rank::ACE), euchre_card(s, e_rank::KING)}))
-                        {
-                            winners += 2;
-                            continue;
-                        }
-
-                        // check if ace is turned down and contains KING and QUEEN suited, 2 winners
-                        if (m_up_card_was_turned_down &&
-                            m_up_card == euchre_card(s, e_rank::ACE) &&
-                            m_hand.contains({euchre_card(s, e_rank::KING), euchre_card(s, e_rank::QUEEN)}))
-                        {
-                            winners += 2;
-                            continue;
-                        }
-
-                        // check if king is turned down and contains ACE and QUEEN suited, 2 winners
-                        if (m_up_card_was_turned_down &&
-                            m_up_card == euchre_card(s, e_rank::KING) &&
-                            m_hand.contains({euchre_card(s, e_rank::ACE), euchre_card(s, e_rank::QUEEN)}))
-                        {
-                            winners += 2;
-                            continue;
-                        }
-
-                        // check if contains ACE
-                        if (m_hand.contains(euchre_card(s, e_rank::ACE)))
-                        {
-                            winners += 1;
-                            continue;
-                        }
-
-                        // check if ace is turned down and contains king
-                        if (m_up_card_was_turned_down &&
-                            m_up_card == euchre_card(s, e_rank::ACE) &&
-                            m_hand.contains(euchre_card(s, e_rank::KING)))
-                        {
-                            winners += 1;
-                            continue;
-                        }
-                    }
-                }
+                        winners += count_suit_winners(m_hand, s, turned_down);
 
                 return winners;
             }
 
-            // count the number of opponents who passed on the up-card
-            uint8_t count_num_opponents_passed_on_up_card() const
-            {
-                uint8_t opponents = 0;
-
-                if (m_left_perception.up_card_offer_decision == e_trump_decision::PASS)
-                    ++opponents;
-
-                if (m_right_perception.up_card_offer_decision == e_trump_decision::PASS)
-                    ++opponents;
-
-                return opponents;
-            }
-
         }; // class score_trump_call_context
 
+        static_assert(std::is_trivially_copyable<score_trump_call_context>::value, "a context never allocates");
+
     } // namespace euchre
 
 } // namespace rda
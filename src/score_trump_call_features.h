@@ -0,0 +1,276 @@
+#pragma once
+
+//
+// score_trump_call_features.h - Trump call scoring as a linear model over binary features
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "platform_defs.h"
+
+#include "euchre_card.h"
+#include "euchre_card_mask.h"
+#include "euchre_card_rank.h"
+#include "euchre_card_suit.h"
+#include "euchre_seat_position.h"
+#include "euchre_trump_decision.h"
+#include "euchre_utils.h"
+#include "score_trump_call_context.h"
+#include "score_trump_call_weights.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        // the value (0 or 1) of each trump call term for a context, indexed by e_trump_call_term.
+        // the score is the dot product of the features with the weights. the thresholds are not
+        // features, and are always 0.
+        typedef std::array<double, static_cast<size_t>(e_trump_call_term::END)> score_trump_call_features;
+
+        // which terms a dot product is taken over
+        enum class e_trump_call_terms : uint8_t
+        {
+            // every term
+            ALL = 0,
+
+            // terms that depend only on the cards in the hand and the trump suit (with the
+            // up-card turned down, the non-trump winner count also depends on the up-card)
+            HAND = 1,
+
+            // terms that depend on the up-card, the dealer and the other players' decisions
+            SITUATION = 2
+
+        }; // enum e_trump_call_terms
+
+        // the values the features of one trump suit are computed from. a context holds the same
+        // values, but these can be filled in for several suits from one scan of the hand.
+        struct score_trump_call_inputs
+        {
+            e_suit suit = e_suit::INVALID;
+            euchre_card_mask hand = euchre_mask::EMPTY;
+            euchre_card up_card;
+            bool up_card_was_turned_down = false;
+            euchre_seat_position dealer_seat_position = euchre_seat_position::INVALID;
+            bool partner_passed_on_up_card = false;
+            uint8_t num_suits = 0;
+            uint8_t num_non_trump_winners = 0;
+            uint8_t num_opponents_passed_on_up_card = 0;
+        };
+
+        namespace score_trump_call
+        {
+            // returns true if a term depends only on the hand (and the trump suit)
+            static bool is_hand_term(const e_trump_call_term term)
+            {
+                return (term >= e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP && term <= e_trump_call_term::HAVE_NINE_TRUMP) ||
+                       (term >= e_trump_call_term::HAVE_ONE_SUITED && term <= e_trump_call_term::HAVE_ZERO_NON_TRUMP_WINNERS);
+            }
+
+            // returns true if a term is scored (the thresholds are not)
+            static bool is_scored_term(const e_trump_call_term term)
+            {
+                return term > e_trump_call_term::TRUMP_CALL_THRESHOLD && term < e_trump_call_term::END;
+            }
+
+            // return the seven trump cards, from the right bower down
+            static std::array<euchre_card, 7> trump_cards(const e_suit suit)
+            {
+                return {{euchre_utils::right_bower(suit),
+                         euchre_utils::left_bower(suit),
+                         euchre_card(suit, e_rank::ACE),
+                         euchre_card(suit, e_rank::KING),
+                         euchre_card(suit, e_rank::QUEEN),
+                         euchre_card(suit, e_rank::TEN),
+                         euchre_card(suit, e_rank::NINE)}};
+            }
+
+            // return the first term of the trump card the dealer would pick up, by where the
+            // dealer sits, or END if there is no dealer
+            static e_trump_call_term pick_up_term(const euchre_seat_position dealer)
+            {
+                if (dealer == euchre_seat_position::SELF)
+                    return e_trump_call_term::WOULD_PICK_UP_RIGHT_BOWER_TRUMP;
+
+                if (dealer == euchre_seat_position::ACROSS)
+                    return e_trump_call_term::PARTNER_WOULD_PICK_UP_RIGHT_BOWER_TRUMP;
+
+                if (dealer == euchre_seat_position::LEFT || dealer == euchre_seat_position::RIGHT)
+                    return e_trump_call_term::OPPONENT_WOULD_PICK_UP_RIGHT_BOWER_TRUMP;
+
+                return e_trump_call_term::END;
+            }
+
+            // return the term "offset" terms after "first"
+            static e_trump_call_term term_after(const e_trump_call_term first, const size_t offset)
+            {
+                return static_cast<e_trump_call_term>(static_cast<size_t>(first) + offset);
+            }
+
+            // set the features of the seven trump cards, from the right bower down, starting at
+            // term "first", to whether "matches" holds for each card
+            template <typename match_type>
+            static void set_trump_card_features(score_trump_call_features &f,
+                                                const e_trump_call_term first,
+                                                const e_suit suit,
+                                                match_type matches)
+            {
+                const std::array<euchre_card, 7> cards = trump_cards(suit);
+
+                for (size_t i = 0; i < cards.size(); ++i)
+                    f[static_cast<size_t>(term_after(first, i))] = matches(cards[i]) ? 1.0f : 0.0f;
+            }
+
+            // return the features of one trump suit
+            static score_trump_call_features extract_features(const score_trump_call_inputs &in)
+            {
+                score_trump_call_features f{};
+
+                // trump cards in the hand
+                set_trump_card_features(f, e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP, in.suit,
+                                        [&](const euchre_card &c) { return (in.hand & euchre_mask::card_bit(c)) != 0; });
+
+                // trump card the dealer would pick up, by where the dealer sits
+                const e_trump_call_term pick_up = pick_up_term(in.dealer_seat_position);
+
+                if (pick_up != e_trump_call_term::END)
+                    set_trump_card_features(f, pick_up, in.suit,
+                                            [&](const euchre_card &c) { return in.up_card == c; });
+
+                // shape of the hand
+                const auto set = [&](const e_trump_call_term term, const bool value) {
+                    f[static_cast<size_t>(term)] = value ? 1.0f : 0.0f;
+                };
+
+                set(e_trump_call_term::HAVE_ONE_SUITED, in.num_suits == 1);
+                set(e_trump_call_term::HAVE_TWO_SUITED, in.num_suits == 2);
+                set(e_trump_call_term::HAVE_THREE_SUITED, in.num_suits == 3);
+                set(e_trump_call_term::HAVE_FOUR_SUITED, in.num_suits == 4);
+
+                set(e_trump_call_term::HAVE_FOUR_NON_TRUMP_WINNERS, in.num_non_trump_winners == 4);
+                set(e_trump_call_term::HAVE_THREE_NON_TRUMP_WINNERS, in.num_non_trump_winners == 3);
+                set(e_trump_call_term::HAVE_TWO_NON_TRUMP_WINNERS, in.num_non_trump_winners == 2);
+                set(e_trump_call_term::HAVE_ONE_NON_TRUMP_WINNERS, in.num_non_trump_winners == 1);
+                set(e_trump_call_term::HAVE_ZERO_NON_TRUMP_WINNERS, in.num_non_trump_winners == 0);
+
+                // other players passing on the up-card, when it is the suit being called
+                const bool up_card_suit = !in.up_card_was_turned_down && in.suit == in.up_card.suit();
+
+                set(e_trump_call_term::PARTNER_PASSED_ON_UP_CARD, up_card_suit && in.partner_passed_on_up_card);
+                set(e_trump_call_term::ONE_OPPONENT_PASSED_ON_UP_CARD, up_card_suit && in.num_opponents_passed_on_up_card == 1);
+                set(e_trump_call_term::TWO_OPPONENTS_PASSED_ON_UP_CARD, up_card_suit && in.num_opponents_passed_on_up_card == 2);
+
+                return f;
+            }
+
+            // return the inputs of a context
+            static score_trump_call_inputs get_inputs(const score_trump_call_context &ctx)
+            {
+                score_trump_call_inputs in;
+                in.suit = ctx.m_suit;
+                in.hand = ctx.m_hand;
+                in.up_card = ctx.m_up_card;
+                in.up_card_was_turned_down = ctx.m_up_card_was_turned_down;
+                in.dealer_seat_position = ctx.m_dealer_seat_position;
+                in.partner_passed_on_up_card = ctx.m_partner_passed_on_up_card;
+                in.num_suits = ctx.m_num_suits;
+                in.num_non_trump_winners = ctx.m_num_non_trump_winners;
+                in.num_opponents_passed_on_up_card = ctx.m_num_opponents_passed_on_up_card;
+
+                return in;
+            }
+
+            // return the features of a context
+            static score_trump_call_features extract_features(const score_trump_call_context &ctx)
+            {
+                return extract_features(get_inputs(ctx));
+            }
+
+            // return the dot product of features with weights, over some of the terms. the terms
+            // are added in order.
+            static double dot(const score_trump_call_features &f,
+                              const score_trump_call_weights &weights,
+                              const e_trump_call_terms terms = e_trump_call_terms::ALL)
+            {
+                double total = 0.0f;
+
+                for (auto t = e_trump_call_term::BEGIN; t != e_trump_call_term::END; ++t)
+                {
+                    if (!is_scored_term(t))
+                        continue;
+
+                    if (terms != e_trump_call_terms::ALL && is_hand_term(t) != (terms == e_trump_call_terms::HAND))
+                        continue;
+
+                    total += f[static_cast<size_t>(t)] * weights.get(t);
+                }
+
+                return total;
+            }
+
+            // return the dot product of the features of one trump suit with weights, over some of
+            // the terms, without building the features. only the terms that are set are added,
+            // in order, so the total is identical to dot(extract_features(in), weights, terms).
+            static double dot(const score_trump_call_inputs &in,
+                              const score_trump_call_weights &weights,
+                              const e_trump_call_terms terms = e_trump_call_terms::ALL)
+            {
+                const bool hand_terms = terms != e_trump_call_terms::SITUATION;
+                const bool situation_terms = terms != e_trump_call_terms::HAND;
+
+                const std::array<euchre_card, 7> cards = trump_cards(in.suit);
+
+                double total = 0.0f;
+
+                // trump cards in the hand
+                if (hand_terms)
+                    for (size_t i = 0; i < cards.size(); ++i)
+                        if (in.hand & euchre_mask::card_bit(cards[i]))
+                            total += weights.get(term_after(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP, i));
+
+                // trump card the dealer would pick up
+                const e_trump_call_term pick_up = pick_up_term(in.dealer_seat_position);
+
+                if (situation_terms && pick_up != e_trump_call_term::END)
+                    for (size_t i = 0; i < cards.size(); ++i)
+                        if (in.up_card == cards[i])
+                            total += weights.get(term_after(pick_up, i));
+
+                // shape of the hand
+                if (hand_terms)
+                {
+                    if (in.num_suits >= 1 && in.num_suits <= 4)
+                        total += weights.get(term_after(e_trump_call_term::HAVE_ONE_SUITED, in.num_suits - 1));
+
+                    if (in.num_non_trump_winners <= 4)
+                        total += weights.get(term_after(e_trump_call_term::HAVE_FOUR_NON_TRUMP_WINNERS, 4 - in.num_non_trump_winners));
+                }
+
+                // other players passing on the up-card, when it is the suit being called
+                if (situation_terms && !in.up_card_was_turned_down && in.suit == in.up_card.suit())
+                {
+                    if (in.partner_passed_on_up_card)
+                        total += weights.get(e_trump_call_term::PARTNER_PASSED_ON_UP_CARD);
+
+                    if (in.num_opponents_passed_on_up_card == 1)
+                        total += weights.get(e_trump_call_term::ONE_OPPONENT_PASSED_ON_UP_CARD);
+                    else if (in.num_opponents_passed_on_up_card == 2)
+                        total += weights.get(e_trump_call_term::TWO_OPPONENTS_PASSED_ON_UP_CARD);
+                }
+
+                return total;
+            }
+
+        } // namespace score_trump_call
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
@@ -0,0 +1,202 @@
+#pragma once
+
+//
+// score_trump_call_table.h - Precomputed hand-only trump call scores for every 5 card hand
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fileio.h"
+
+#include "euchre_card_mask.h"
+#include "euchre_card_suit.h"
+#include "euchre_constants.h"
+#include "score_trump_call_weights.h"
+
+namespace rda
+{
+    namespace euchre
+    {
+        // table of the hand-only portion of the trump call score, for each of the
+        // C(24,5) = 42,504 five card hands and each of the four trump suits
+        class score_trump_call_table
+        {
+        public:
+            // number of distinct five card hands
+            static const uint32_t NUM_HANDS = 42504;
+
+        private:
+            // identifies a saved table file
+            static const uint64_t FILE_MAGIC = 0x31425443484555ULL; // "EUCHTB1"
+
+            // the weights the table was computed from
+            std::shared_ptr<const score_trump_call_weights> m_weights;
+
+            // scores, indexed by (hand_index * NUM_SUITS + suit)
+            std::vector<double> m_scores;
+
+            // binomial coefficients C(n, k) for n < 24, k <= 5
+            static const std::array<std::array<uint32_t, euchre_constants::EUCHRE_HAND_SIZE + 1>, euchre_constants::NUM_CARDS> &binomials()
+            {
+                static const auto table = []() {
+                    std::array<std::array<uint32_t, euchre_constants::EUCHRE_HAND_SIZE + 1>, euchre_constants::NUM_CARDS> c{};
+
+                    for (size_t n = 0; n < c.size(); ++n)
+                    {
+                        c[n][0] = 1;
+                        for (size_t k = 1; k < c[n].size(); ++k)
+                            c[n][k] = (n == 0) ? 0 : c[n - 1][k - 1] + c[n - 1][k];
+                    }
+
+                    return c;
+                }();
+
+                return table;
+            }
+
+        public:
+            // constructor, with the weights the table is computed from
+            score_trump_call_table(const std::shared_ptr<const score_trump_call_weights> &weights)
+                : m_weights(weights),
+                  m_scores(NUM_HANDS * euchre_constants::NUM_SUITS, 0.0f)
+            {
+            }
+
+            // return the canonical index (0 - 42503) of a five card hand mask. hands are
+            // numbered in colexicographic order, which is increasing order of the mask value.
+            static uint32_t hand_index(const euchre_card_mask mask)
+            {
+                uint32_t index = 0;
+                size_t k = 1;
+
+                for (euchre_card_mask m = mask; m != 0; m &= m - 1)
+                    index += binomials()[euchre_mask::lowest_index(m)][k++];
+
+                return index;
+            }
+
+            // return the next larger mask with the same number of cards
+            static euchre_card_mask next_hand(const euchre_card_mask mask)
+            {
+                const euchre_card_mask lowest = mask & (~mask + 1);
+                const euchre_card_mask ripple = mask + lowest;
+                return ripple | (((mask ^ ripple) >> 2) / lowest);
+            }
+
+            // the first five card hand in canonical order
+            static euchre_card_mask first_hand()
+            {
+                return (euchre_card_mask(1) << euchre_constants::EUCHRE_HAND_SIZE) - 1;
+            }
+
+            // return the weights the table was computed from
+            const std::shared_ptr<const score_trump_call_weights> &weights() const
+            {
+                return m_weights;
+            }
+
+            // set the score for a hand and trump suit
+            void set(const euchre_card_mask hand, const e_suit trump, const double score)
+            {
+                m_scores[hand_index(hand) * euchre_constants::NUM_SUITS + static_cast<size_t>(trump)] = score;
+            }
+
+            // return the score for a five card hand and trump suit
+            double lookup(const euchre_card_mask hand, const e_suit trump) const
+            {
+                return m_scores[hand_index(hand) * euchre_constants::NUM_SUITS + static_cast<size_t>(trump)];
+            }
+
+            // write the table to a binary file
+            bool save(const std::string &path) const
+            {
+                rda::fileio f(path);
+
+                const uint64_t magic = FILE_MAGIC;
+
+                size_t pos = 0;
+                bool ok = f.put_raw(pos, magic);
+                pos += sizeof(magic);
+
+                for (auto &w : m_weights->values)
+                {
+                    ok = ok && f.put_raw(pos, w);
+                    pos += sizeof(w);
+                }
+
+                for (auto &s : m_scores)
+                {
+                    ok = ok && f.put_raw(pos, s);
+                    pos += sizeof(s);
+                }
+
+                return ok && f.write();
+            }
+
+            // read a table from a binary file. returns nullptr if the file is missing or
+            // corrupt, or was computed from different weights.
+            static std::shared_ptr<score_trump_call_table> load(const std::string &path,
+                                                                const std::shared_ptr<const score_trump_call_weights> &weights)
+            {
+                rda::fileio f(path);
+                if (!f.read())
+                    return nullptr;
+
+                size_t pos = 0;
+                uint64_t magic = 0;
+                if (!f.get_raw(pos, magic) || magic != FILE_MAGIC)
+                    return nullptr;
+                pos += sizeof(magic);
+
+                for (auto &w : weights->values)
+                {
+                    double saved = 0.0f;
+                    if (!f.get_raw(pos, saved) || std::memcmp(&saved, &w, sizeof(w)) != 0)
+                        return nullptr;
+                    pos += sizeof(saved);
+                }
+
+                auto table = std::make_shared<score_trump_call_table>(weights);
+
+                for (auto &s : table->m_scores)
+                {
+                    if (!f.get_raw(pos, s))
+                        return nullptr;
+                    pos += sizeof(s);
+                }
+
+                return table;
+            }
+
+            // return the table currently used for scoring (nullptr if disabled)
+            static std::shared_ptr<const score_trump_call_table> current()
+            {
+                return std::atomic_load(&current_storage());
+            }
+
+            // set the table used for scoring (nullptr to disable)
+            static void set_current(const std::shared_ptr<const score_trump_call_table> &table)
+            {
+                std::atomic_store(&current_storage(), table);
+            }
+
+        private:
+            // the shared instance of the table in use
+            static std::shared_ptr<const score_trump_call_table> &current_storage()
+            {
+                static std::shared_ptr<const score_trump_call_table> storage;
+                return storage;
+            }
+
+        }; // class score_trump_call_table
+
+    } // namespace euchre
+
+} // namespace rda
@@ -0,0 +1,321 @@
+#pragma once
+
+//
+// score_trump_call_tuner.h - Genetic algorithm tuning the trump call weights by self-play
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "fileio.h"
+#include "json.h"
+
+#include "euchre_deal_log.h"
+#include "euchre_tournament.h"
+#include "random_seeder.h"
+#include "score_trump_call_weights.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        // settings for tuning the trump call weights
+        struct score_trump_call_tuner_settings
+        {
+            // number of generations to run (counting generations loaded from a checkpoint)
+            uint32_t generations = 20;
+
+            // number of candidate weights in each generation
+            uint32_t population = 16;
+
+            // number of the best candidates kept unchanged in the next generation
+            uint32_t elites = 4;
+
+            // number of duplicate boards each candidate plays against the baseline, per generation
+            uint64_t boards = 2000;
+
+            // standard deviation of a mutation, relative to the size of the weight (at least 1)
+            double mutation_scale = 0.15f;
+
+            // chance of mutating each weight of a new candidate
+            double mutation_rate = 0.25f;
+
+            // worker threads playing each tournament
+            unsigned int num_threads = std::thread::hardware_concurrency();
+
+            // seed for the deals and the genetic operators
+            uint64_t seed = 0;
+
+            // file the population is saved to after each generation, and resumed from (empty for
+            // no checkpoints)
+            std::string checkpoint_path;
+        };
+
+        // one candidate set of weights, and how it played against the baseline
+        struct score_trump_call_candidate
+        {
+            score_trump_call_weights weights;
+
+            // mean points per hand the candidate scored more than the baseline
+            double fitness = 0.0f;
+
+            // standard error of the fitness
+            double std_error = 0.0f;
+        };
+
+        // state of a tuning run
+        struct score_trump_call_tuner_state
+        {
+            // the weights candidates are measured against
+            score_trump_call_weights baseline;
+
+            // number of generations evaluated so far
+            uint32_t generation = 0;
+
+            // the candidates of the current generation. after a generation is evaluated, they are
+            // sorted from the best fitness down.
+            std::vector<score_trump_call_candidate> population;
+
+            // the best candidate of the last generation evaluated
+            score_trump_call_candidate best;
+
+            // return a string representation of the progress
+            std::string to_string() const
+            {
+                std::stringstream ss;
+
+                ss << "generation: " << generation
+                   << " best_fitness: " << best.fitness
+                   << " std_error: " << best.std_error
+                   << " trump_call_threshold: " << best.weights.get(e_trump_call_term::TRUMP_CALL_THRESHOLD)
+                   << " loner_call_threshold: " << best.weights.get(e_trump_call_term::LONER_CALL_THRESHOLD);
+
+                return ss.str();
+            }
+
+            // return the state as json
+            std::shared_ptr<rda::json::node_object> to_json() const
+            {
+                std::vector<std::shared_ptr<rda::json::node>> candidates;
+
+                for (auto &c : population)
+                    candidates.push_back(std::make_shared<rda::json::node_object>("", std::vector<std::shared_ptr<rda::json::node>>{c.weights.to_json()}));
+
+                return std::make_shared<rda::json::node_object>(
+                    "",
+                    std::vector<std::shared_ptr<rda::json::node>>{
+                        std::make_shared<rda::json::node_integer>("generation", generation),
+                        std::make_shared<rda::json::node_float>("best_fitness", best.fitness),
+                        std::make_shared<rda::json::node_float>("best_std_error", best.std_error),
+                        std::make_shared<rda::json::node_object>("baseline", std::vector<std::shared_ptr<rda::json::node>>{baseline.to_json()}),
+                        std::make_shared<rda::json::node_array>("population", candidates)});
+            }
+
+            // save the state to a checkpoint file. returns false if it could not be written.
+            bool save(const std::string &path) const
+            {
+                rda::fileio f(path);
+                return f.set(to_json()->to_simple_string() + "\n") && f.write();
+            }
+
+            // load the state from a checkpoint file. returns false if the file could not be read.
+            bool load(const std::string &path)
+            {
+                rda::fileio f(path);
+                if (!f.read())
+                    return false;
+
+                const auto data = rda::json::parse(f.to_string());
+                if (data == nullptr)
+                    return false;
+
+                const auto baseline_data = data->get_object_by_path("baseline");
+                const auto population_data = data->get_array_by_path("population");
+                if (baseline_data == nullptr || population_data == nullptr || population_data->data.empty())
+                    return false;
+
+                generation = static_cast<uint32_t>(data->get_integer_by_path("generation"));
+                baseline.load(*baseline_data);
+
+                population.clear();
+                for (auto &n : population_data->data)
+                {
+                    const auto candidate_data = std::dynamic_pointer_cast<rda::json::node_object>(n);
+                    if (candidate_data == nullptr)
+                        return false;
+
+                    score_trump_call_candidate c;
+                    c.weights.load(*candidate_data);
+                    population.push_back(c);
+                }
+
+                // the best candidate is kept first, as an elite
+                best = population.front();
+                best.fitness = data->get_number_by_path("best_fitness");
+                best.std_error = data->get_number_by_path("best_std_error");
+
+                return true;
+            }
+        };
+
+        namespace score_trump_call_tuner
+        {
+            // return a copy of "weights" with some of the weights moved by a random amount
+            static score_trump_call_weights mutate(const score_trump_call_weights &weights,
+                                                   const score_trump_call_tuner_settings &settings,
+                                                   euchre_random_engine &engine)
+            {
+                score_trump_call_weights result = weights;
+
+                std::uniform_real_distribution<double> chance(0.0f, 1.0f);
+                std::normal_distribution<double> step(0.0f, settings.mutation_scale);
+
+                for (auto &w : result.values)
+                    if (chance(engine) < settings.mutation_rate)
+                        w += step(engine) * std::max(std::abs(w), 1.0);
+
+                return result;
+            }
+
+            // return weights taking each weight from one parent or the other at random
+            static score_trump_call_weights crossover(const score_trump_call_weights &a,
+                                                      const score_trump_call_weights &b,
+                                                      euchre_random_engine &engine)
+            {
+                score_trump_call_weights result = a;
+
+                for (size_t i = 0; i < result.values.size(); ++i)
+                    if (engine() & 1)
+                        result.values[i] = b.values[i];
+
+                return result;
+            }
+
+            // start a tuning run from the baseline weights. the first generation is the baseline
+            // and mutations of it.
+            static score_trump_call_tuner_state start(const score_trump_call_weights &baseline,
+                                                     const score_trump_call_tuner_settings &settings)
+            {
+                score_trump_call_tuner_state state;
+                state.baseline = baseline;
+
+                euchre_random_engine engine(settings.seed, 0);
+
+                state.population.resize(std::max<uint32_t>(settings.population, 1));
+                state.population[0].weights = baseline;
+
+                for (size_t i = 1; i < state.population.size(); ++i)
+                    state.population[i].weights = mutate(baseline, settings, engine);
+
+                state.best = state.population[0];
+
+                return state;
+            }
+
+            // play every candidate of the current generation against the baseline, and sort the
+            // population from the best fitness down. every candidate plays the same deals, which
+            // are new each generation.
+            static void evaluate(score_trump_call_tuner_state &state, const score_trump_call_tuner_settings &settings)
+            {
+                euchre_random_engine engine(settings.seed, state.generation + 1);
+                const euchre_deal_log deals = make_random_deals(settings.boards, engine());
+                const uint64_t game_seed = engine();
+
+                const euchre_contender baseline{euchre_algo::pimc_settings(), std::make_shared<const score_trump_call_weights>(state.baseline)};
+
+                for (auto &c : state.population)
+                {
+                    const euchre_contender candidate{euchre_algo::pimc_settings(), std::make_shared<const score_trump_call_weights>(c.weights)};
+                    const euchre_duplicate_result result = run_duplicate_tournament(deals, game_seed, candidate, baseline, settings.num_threads);
+
+                    c.fitness = result.mean;
+                    c.std_error = result.std_error;
+                }
+
+                std::stable_sort(state.population.begin(), state.population.end(),
+                                 [](const score_trump_call_candidate &lhs, const score_trump_call_candidate &rhs) {
+                                     return lhs.fitness > rhs.fitness;
+                                 });
+
+                state.best = state.population.front();
+                ++state.generation;
+            }
+
+            // replace the population with the next generation: the elites unchanged, then children
+            // of parents picked by tournament selection, crossed over and mutated
+            static void breed(score_trump_call_tuner_state &state, const score_trump_call_tuner_settings &settings)
+            {
+                euchre_random_engine engine(settings.seed, state.generation + 0x10000);
+
+                const size_t size = state.population.size();
+                const size_t elites = std::min<size_t>(std::max<uint32_t>(settings.elites, 1), size);
+
+                // the population is sorted, so the better of two random indexes is the lower one
+                const auto select = [&]() -> const score_trump_call_weights & {
+                    std::uniform_int_distribution<size_t> pick(0, size - 1);
+                    return state.population[std::min(pick(engine), pick(engine))].weights;
+                };
+
+                std::vector<score_trump_call_candidate> next(state.population.cbegin(), state.population.cbegin() + elites);
+
+                while (next.size() < size)
+                {
+                    score_trump_call_candidate child;
+                    child.weights = mutate(crossover(select(), select(), engine), settings, engine);
+                    next.push_back(child);
+                }
+
+                state.population = next;
+            }
+
+            // tune the weights, starting from "baseline" or from the checkpoint if there is one,
+            // until the number of generations in the settings have been evaluated. "progress" is
+            // called after each generation. returns the final state; its best candidate holds the
+            // tuned weights.
+            static score_trump_call_tuner_state run(const score_trump_call_weights &baseline,
+                                                   const score_trump_call_tuner_settings &settings,
+                                                   const std::function<void(const score_trump_call_tuner_state &)> &progress = nullptr)
+            {
+                score_trump_call_tuner_state state;
+
+                if (settings.checkpoint_path.empty() || !state.load(settings.checkpoint_path))
+                    state = start(baseline, settings);
+
+                while (state.generation < settings.generations)
+                {
+                    evaluate(state, settings);
+
+                    if (progress)
+                        progress(state);
+
+                    breed(state, settings);
+
+                    if (!settings.checkpoint_path.empty())
+                        state.save(settings.checkpoint_path);
+                }
+
+                return state;
+            }
+
+        } // namespace score_trump_call_tuner
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
@@ -0,0 +1,257 @@
+#pragma once
+
+//
+// score_trump_call_weights.h - Weights used when scoring the calling of a trump suit
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "platform_defs.h"
+
+#include "fileio.h"
+#include "json.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE_GCC("-Wunused-function")
+
+namespace rda
+{
+    namespace euchre
+    {
+        // each weight read from the "trump_call" object of euchre.json
+        enum class e_trump_call_term : uint8_t
+        {
+            LONER_CALL_THRESHOLD = 0,
+            BEGIN = 0,
+            TRUMP_CALL_THRESHOLD = 1,
+            HAVE_RIGHT_BOWER_TRUMP = 2,
+            HAVE_LEFT_BOWER_TRUMP = 3,
+            HAVE_ACE_TRUMP = 4,
+            HAVE_KING_TRUMP = 5,
+            HAVE_QUEEN_TRUMP = 6,
+            HAVE_TEN_TRUMP = 7,
+            HAVE_NINE_TRUMP = 8,
+            WOULD_PICK_UP_RIGHT_BOWER_TRUMP = 9,
+            WOULD_PICK_UP_LEFT_BOWER_TRUMP = 10,
+            WOULD_PICK_UP_ACE_TRUMP = 11,
+            WOULD_PICK_UP_KING_TRUMP = 12,
+            WOULD_PICK_UP_QUEEN_TRUMP = 13,
+            WOULD_PICK_UP_TEN_TRUMP = 14,
+            WOULD_PICK_UP_NINE_TRUMP = 15,
+            PARTNER_WOULD_PICK_UP_RIGHT_BOWER_TRUMP = 16,
+            PARTNER_WOULD_PICK_UP_LEFT_BOWER_TRUMP = 17,
+            PARTNER_WOULD_PICK_UP_ACE_TRUMP = 18,
+            PARTNER_WOULD_PICK_UP_KING_TRUMP = 19,
+            PARTNER_WOULD_PICK_UP_QUEEN_TRUMP = 20,
+            PARTNER_WOULD_PICK_UP_TEN_TRUMP = 21,
+            PARTNER_WOULD_PICK_UP_NINE_TRUMP = 22,
+            OPPONENT_WOULD_PICK_UP_RIGHT_BOWER_TRUMP = 23,
+            OPPONENT_WOULD_PICK_UP_LEFT_BOWER_TRUMP = 24,
+            OPPONENT_WOULD_PICK_UP_ACE_TRUMP = 25,
+            OPPONENT_WOULD_PICK_UP_KING_TRUMP = 26,
+            OPPONENT_WOULD_PICK_UP_QUEEN_TRUMP = 27,
+            OPPONENT_WOULD_PICK_UP_TEN_TRUMP = 28,
+            OPPONENT_WOULD_PICK_UP_NINE_TRUMP = 29,
+            HAVE_ONE_SUITED = 30,
+            HAVE_TWO_SUITED = 31,
+            HAVE_THREE_SUITED = 32,
+            HAVE_FOUR_SUITED = 33,
+            HAVE_FOUR_NON_TRUMP_WINNERS = 34,
+            HAVE_THREE_NON_TRUMP_WINNERS = 35,
+            HAVE_TWO_NON_TRUMP_WINNERS = 36,
+            HAVE_ONE_NON_TRUMP_WINNERS = 37,
+            HAVE_ZERO_NON_TRUMP_WINNERS = 38,
+            PARTNER_PASSED_ON_UP_CARD = 39,
+            ONE_OPPONENT_PASSED_ON_UP_CARD = 40,
+            TWO_OPPONENTS_PASSED_ON_UP_CARD = 41,
+            END = 42
+
+        }; // enum e_trump_call_term
+
+        // operator for iterating over trump call terms
+        static e_trump_call_term operator++(e_trump_call_term &rhs)
+        {
+            if (rhs < e_trump_call_term::END)
+                rhs = static_cast<e_trump_call_term>(static_cast<uint8_t>(rhs) + 1);
+            return rhs;
+        }
+
+        // return the json key of a trump call term (relative to the "trump_call" object)
+        static const char *to_key(const e_trump_call_term term)
+        {
+            static const char *const KEYS[static_cast<size_t>(e_trump_call_term::END)] =
+                {
+                    "loner_call_threshold",
+                    "trump_call_threshold",
+                    "have_right_bower_trump",
+                    "have_left_bower_trump",
+                    "have_ace_trump",
+                    "have_king_trump",
+                    "have_queen_trump",
+                    "have_ten_trump",
+                    "have_nine_trump",
+                    "would_pick_up_right_bower_trump",
+                    "would_pick_up_left_bower_trump",
+                    "would_pick_up_ace_trump",
+                    "would_pick_up_king_trump",
+                    "would_pick_up_queen_trump",
+                    "would_pick_up_ten_trump",
+                    "would_pick_up_nine_trump",
+                    "partner_would_pick_up_right_bower_trump",
+                    "partner_would_pick_up_left_bower_trump",
+                    "partner_would_pick_up_ace_trump",
+                    "partner_would_pick_up_king_trump",
+                    "partner_would_pick_up_queen_trump",
+                    "partner_would_pick_up_ten_trump",
+                    "partner_would_pick_up_nine_trump",
+                    "opponent_would_pick_up_right_bower_trump",
+                    "opponent_would_pick_up_left_bower_trump",
+                    "opponent_would_pick_up_ace_trump",
+                    "opponent_would_pick_up_king_trump",
+                    "opponent_would_pick_up_queen_trump",
+                    "opponent_would_pick_up_ten_trump",
+                    "opponent_would_pick_up_nine_trump",
+                    "have_one_suited",
+                    "have_two_suited",
+                    "have_three_suited",
+                    "have_four_suited",
+                    "have_four_non_trump_winners",
+                    "have_three_non_trump_winners",
+                    "have_two_non_trump_winners",
+                    "have_one_non_trump_winners",
+                    "have_zero_non_trump_winners",
+                    "partner_passed_on_up_card",
+                    "one_opponent_passed_on_up_card",
+                    "two_opponents_passed_on_up_card"};
+
+            if (term >= e_trump_call_term::END)
+                return "";
+
+            return KEYS[static_cast<size_t>(term)];
+        }
+
+        // flat table of trump call weights, indexed by e_trump_call_term
+        struct score_trump_call_weights
+        {
+            // the weight of each term
+            std::array<double, static_cast<size_t>(e_trump_call_term::END)> values{};
+
+            // return the weight of a term
+            double get(const e_trump_call_term term) const
+            {
+                return values[static_cast<size_t>(term)];
+            }
+
+            // set the weight of a term
+            void set(const e_trump_call_term term, const double value)
+            {
+                values[static_cast<size_t>(term)] = value;
+            }
+
+            // load the weights from parsed json data. missing terms are weighted 0.
+            void load(const rda::json::node_object &data)
+            {
+                for (auto t = e_trump_call_term::BEGIN; t != e_trump_call_term::END; ++t)
+                    set(t, data.get_number_by_path(std::string("trump_call/") + to_key(t)));
+            }
+
+            // load the weights from a json file. returns false if the file could not be parsed.
+            bool load_file(const std::string &path)
+            {
+                rda::fileio f(path);
+                if (!f.read())
+                    return false;
+
+                const auto data = rda::json::parse(f.to_string());
+                if (data == nullptr)
+                    return false;
+
+                load(*data);
+                return true;
+            }
+
+            // return the weights as a "trump_call" json object
+            std::shared_ptr<rda::json::node_object> to_json() const
+            {
+                std::vector<std::shared_ptr<rda::json::node>> children;
+
+                for (auto t = e_trump_call_term::BEGIN; t != e_trump_call_term::END; ++t)
+                    children.push_back(std::make_shared<rda::json::node_float>(to_key(t), get(t)));
+
+                return std::make_shared<rda::json::node_object>("trump_call", children);
+            }
+
+            // write the weights to a json file. the "trump_call" object of an existing file is
+            // replaced, and the rest of the file is kept. returns false if the file could not be
+            // written.
+            bool save_file(const std::string &path) const
+            {
+                rda::fileio f(path);
+
+                std::shared_ptr<rda::json::node_object> data;
+                if (f.read())
+                    data = rda::json::parse(f.to_string());
+
+                if (data == nullptr)
+                    data = std::make_shared<rda::json::node_object>("", std::vector<std::shared_ptr<rda::json::node>>());
+
+                // keep the position of the existing object
+                size_t index = 0;
+                while (index < data->data.size() && data->data[index]->key != "trump_call")
+                    ++index;
+
+                data->remove_child(index);
+                data->add_child(to_json(), index);
+
+                return f.set(data->to_pretty_string() + "\n") && f.write();
+            }
+
+            // return the weights currently in use by the engine (loaded from euchre.json on first use)
+            static std::shared_ptr<const score_trump_call_weights> current()
+            {
+                return std::atomic_load(&current_storage());
+            }
+
+            // replace the weights currently in use by the engine
+            static void set_current(const score_trump_call_weights &weights)
+            {
+                std::atomic_store(&current_storage(), std::shared_ptr<const score_trump_call_weights>(std::make_shared<score_trump_call_weights>(weights)));
+            }
+
+            // re-read the weights from a json file, and use them for all later scoring.
+            // scoring already in progress keeps the weights it started with.
+            static bool reload(const std::string &path = "euchre.json")
+            {
+                score_trump_call_weights weights;
+                if (!weights.load_file(path))
+                    return false;
+
+                set_current(weights);
+                return true;
+            }
+
+        private:
+            // the shared instance of the weights in use
+            static std::shared_ptr<const score_trump_call_weights> &current_storage()
+            {
+                static std::shared_ptr<const score_trump_call_weights> storage = []() {
+                    auto weights = std::make_shared<score_trump_call_weights>();
+                    weights->load_file("euchre.json");
+                    return std::shared_ptr<const score_trump_call_weights>(weights);
+                }();
+
+                return storage;
+            }
+        };
+
+    } // namespace euchre
+
+} // namespace rda
+
+POP_WARN_DISABLE
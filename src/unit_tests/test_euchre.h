@@ -6,9 +6,16 @@
 // Written by Ryan Antkowiak 
 //
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <random>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "unit_test_utils.h"
@@ -18,15 +25,28 @@
 #include "../fileio.h"
 #include "../json.h"
 
+#include "../euchre_algo_deal_sampler.h"
+#include "../euchre_algo_pimc.h"
 #include "../euchre_card.h"
+#include "../euchre_card_mask.h"
+#include "../euchre_deal_log.h"
 #include "../euchre_deck.h"
+#include "../euchre_game.h"
 #include "../euchre_hand.h"
 #include "../euchre_perception.h"
 #include "../euchre_player.h"
 #include "../euchre_player_computer.h"
 #include "../euchre_player_human.h"
+#include "../euchre_simulator.h"
+#include "../euchre_tournament.h"
 #include "../random_seeder.h"
 #include "../score_trump_call.h"
+#include "../score_trump_call_batch.h"
+#include "../score_trump_call_features.h"
+#include "../score_trump_call_table.h"
+#include "../score_trump_call_tuner.h"
+#include "../score_trump_call_weights.h"
+#include "../work_stealing_pool.h"
 
 PUSH_WARN_DISABLE
 WARN_DISABLE(4100, "-Wunused-parameter")
@@ -65,38 +85,875 @@ namespace rda
 
         static void test_001(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            // every card maps to a unique bit, and back again
+            euchre_card_mask all = euchre_mask::EMPTY;
+            for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                for (auto r = e_rank::BEGIN; r != e_rank::END; ++r)
+                {
+                    const euchre_card c(s, r);
+                    ASSERT_TRUE(euchre_mask::card_from_index(euchre_mask::card_index(c)) == c, "card index round trip");
+                    ASSERT_FALSE(all & euchre_mask::card_bit(c), "card bits are unique");
+                    all |= euchre_mask::card_bit(c);
+                }
+            ASSERT_TRUE(all == euchre_mask::FULL_DECK, "full deck mask");
+            ASSERT_TRUE(euchre_mask::card_bit(euchre_card()) == euchre_mask::EMPTY, "invalid card has no bit");
+
+            // trump-relative masks include the left bower
+            ASSERT_TRUE(euchre_mask::popcount(euchre_mask::trump_mask(e_suit::HEARTS)) == 7);
+            ASSERT_TRUE(euchre_mask::popcount(euchre_mask::effective_suit_mask(e_suit::DIAMONDS, e_suit::HEARTS)) == 5);
+            ASSERT_TRUE(euchre_mask::popcount(euchre_mask::effective_suit_mask(e_suit::CLUBS, e_suit::HEARTS)) == 6);
+            ASSERT_TRUE(euchre_mask::left_bower_mask(e_suit::SPADES) == euchre_mask::card_bit(euchre_card(e_suit::CLUBS, e_rank::JACK)));
+
+            // hand membership and suit counts
+            euchre_hand hand;
+            hand.add_cards({{e_suit::HEARTS, e_rank::JACK}, {e_suit::DIAMONDS, e_rank::JACK}, {e_suit::HEARTS, e_rank::NINE}, {e_suit::CLUBS, e_rank::ACE}, {e_suit::SPADES, e_rank::TEN}});
+            ASSERT_TRUE(hand.size() == 5);
+            ASSERT_TRUE(hand.contains(euchre_card(e_suit::CLUBS, e_rank::ACE)));
+            ASSERT_FALSE(hand.contains(euchre_card(e_suit::CLUBS, e_rank::KING)));
+            ASSERT_TRUE(hand.contains({{e_suit::HEARTS, e_rank::JACK}, {e_suit::DIAMONDS, e_rank::JACK}}));
+            ASSERT_TRUE(hand.count_suit(e_suit::HEARTS, e_suit::HEARTS) == 3);
+            ASSERT_TRUE(hand.count_suit(e_suit::DIAMONDS, e_suit::HEARTS) == 0);
+            ASSERT_TRUE(hand.count_suit(e_suit::DIAMONDS, e_suit::CLUBS) == 1);
+
+            hand.remove_card(euchre_card(e_suit::HEARTS, e_rank::NINE));
+            ASSERT_TRUE(hand.size() == 4);
+            ASSERT_FALSE(hand.contains(euchre_card(e_suit::HEARTS, e_rank::NINE)));
+            ASSERT_TRUE(*hand.cbegin() == euchre_card(e_suit::HEARTS, e_rank::JACK));
+            ASSERT_TRUE(*(hand.cend() - 1) == euchre_card(e_suit::SPADES, e_rank::TEN));
         }
 
         static void test_002(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            // makers take 3 tricks for 1 point
+            euchre_scoreboard sb;
+            sb.add_trick(0);
+            sb.add_trick(2);
+            sb.add_trick(0);
+            sb.add_trick(1);
+            sb.add_trick(3);
+            sb.score_hand(2, false);
+            ASSERT_TRUE(sb.team1_score == 1 && sb.team2_score == 0, "makers score 1 point");
+
+            // makers euchred, defenders take 2 points
+            sb.reset_hand();
+            sb.add_trick(1);
+            sb.add_trick(1);
+            sb.add_trick(3);
+            sb.add_trick(0);
+            sb.add_trick(2);
+            sb.score_hand(0, false);
+            ASSERT_TRUE(sb.team1_score == 1 && sb.team2_score == 2, "defenders score 2 points");
+
+            // loner march is 4 points
+            sb.reset_hand();
+            for (int i = 0; i < 5; ++i)
+                sb.add_trick(3);
+            sb.score_hand(3, true);
+            ASSERT_TRUE(sb.team2_score == 6, "loner march scores 4 points");
+
+            // a headless game plays to completion
+            euchre_game game(true);
+            game.play_game();
+            ASSERT_TRUE(game.get_scoreboard().is_over(), "game is over");
+            ASSERT_TRUE(game.get_hands_played() > 0, "hands were played");
         }
 
         static void test_003(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            // the same seed reproduces the same games, with any number of threads
+            const euchre_simulation_result r1 = run_parallel_simulation(4, 1234, 2);
+            const euchre_simulation_result r2 = run_parallel_simulation(4, 1234, 3);
+
+            ASSERT_TRUE(r1.games == 4 && r2.games == 4, "all games were played");
+            ASSERT_TRUE(r1.hands == r2.hands, "same number of hands");
+            ASSERT_TRUE(r1.team1_points == r2.team1_points && r1.team2_points == r2.team2_points, "same points");
+            ASSERT_TRUE(r1.team1_wins + r1.team2_wins == r1.games, "every game has a winner");
+
+            const euchre_simulation_result r3 = run_simulation(4, 1234);
+            ASSERT_TRUE(r1.hands == r3.hands && r1.team1_points == r3.team1_points, "same games on one thread");
         }
 
         static void test_004(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            score_trump_call_weights weights;
+            ASSERT_TRUE(weights.load_file("euchre.json"), "load euchre.json");
+            ASSERT_TRUE(weights.get(e_trump_call_term::TRUMP_CALL_THRESHOLD) == 14.0f);
+            ASSERT_TRUE(weights.get(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP) == 8.0f);
+            ASSERT_TRUE(weights.get(e_trump_call_term::WOULD_PICK_UP_LEFT_BOWER_TRUMP) == 0.0f, "missing term is 0");
+            ASSERT_FALSE(weights.load_file("does_not_exist.json"));
+            ASSERT_TRUE(std::string(to_key(e_trump_call_term::TWO_OPPONENTS_PASSED_ON_UP_CARD)) == "two_opponents_passed_on_up_card");
+
+            // swapping the current weights changes the scoring of later calls
+            euchre_hand hand;
+            hand.add_cards({{e_suit::HEARTS, e_rank::JACK}, {e_suit::CLUBS, e_rank::NINE}, {e_suit::CLUBS, e_rank::TEN}, {e_suit::SPADES, e_rank::NINE}, {e_suit::SPADES, e_rank::TEN}});
+            const euchre_perception left(1), partner(2), right(3);
+
+            const double before = score_trump_call::score(e_suit::HEARTS, hand, euchre_card(e_suit::DIAMONDS, e_rank::NINE), false, euchre_seat_position::LEFT, left, partner, right).get_total_score();
+
+            score_trump_call_weights doubled = weights;
+            doubled.set(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP, 2.0f * weights.get(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP));
+            score_trump_call_weights::set_current(doubled);
+
+            const double after = score_trump_call::score(e_suit::HEARTS, hand, euchre_card(e_suit::DIAMONDS, e_rank::NINE), false, euchre_seat_position::LEFT, left, partner, right).get_total_score();
+            ASSERT_TRUE(after - before == weights.get(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP), "scoring uses the current weights");
+
+            ASSERT_TRUE(score_trump_call_weights::reload(), "reload euchre.json");
+            ASSERT_TRUE(score_trump_call_weights::current()->get(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP) == 8.0f);
         }
 
         static void test_005(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            // every five card hand has a unique index, in increasing order
+            uint32_t expected = 0;
+            for (euchre_card_mask m = score_trump_call_table::first_hand(); m <= euchre_mask::FULL_DECK; m = score_trump_call_table::next_hand(m))
+            {
+                if (score_trump_call_table::hand_index(m) != expected)
+                    ASSERT_TRUE(false, "hand index is canonical");
+                ++expected;
+            }
+            ASSERT_TRUE(expected == score_trump_call_table::NUM_HANDS, "C(24,5) hands");
+
+            // scores read from the table match scores computed term by term
+            std::vector<euchre_card> deck;
+            for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                for (auto r = e_rank::BEGIN; r != e_rank::END; ++r)
+                    deck.push_back(euchre_card(s, r));
+
+            euchre_perception left(1), partner(2), right(3);
+            partner.up_card_offer_decision = e_trump_decision::PASS;
+            left.up_card_offer_decision = e_trump_decision::PASS;
+
+            const auto table = score_trump_call::build_table(score_trump_call_weights::current());
+
+            for (int i = 0; i < 200; ++i)
+            {
+                std::shuffle(deck.begin(), deck.end(), get_random_engine());
+
+                euchre_hand hand;
+                hand.add_cards(std::vector<euchre_card>(deck.cbegin(), deck.cbegin() + 5));
+                const euchre_card up_card = deck[5];
+                const auto dealer = static_cast<euchre_seat_position>(i % 4);
+
+                for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                {
+                    score_trump_call_table::set_current(nullptr);
+                    const double computed = score_trump_call::score(s, hand, up_card, false, dealer, left, partner, right).get_total_score();
+
+                    score_trump_call_table::set_current(table);
+                    const double looked_up = score_trump_call::score(s, hand, up_card, false, dealer, left, partner, right).get_total_score();
+
+                    ASSERT_TRUE(computed == looked_up, "table score matches computed score");
+                }
+            }
+
+            // a saved table can be loaded back for the same weights only
+            ASSERT_TRUE(table->save("test_score_trump_call_table.bin"), "save table");
+            const auto loaded = score_trump_call_table::load("test_score_trump_call_table.bin", score_trump_call_weights::current());
+            ASSERT_TRUE(loaded != nullptr, "load table");
+            ASSERT_TRUE(loaded->lookup(0x1F, e_suit::CLUBS) == table->lookup(0x1F, e_suit::CLUBS));
+
+            score_trump_call_weights other = *score_trump_call_weights::current();
+            other.set(e_trump_call_term::HAVE_NINE_TRUMP, 100.0f);
+            ASSERT_TRUE(score_trump_call_table::load("test_score_trump_call_table.bin", std::make_shared<score_trump_call_weights>(other)) == nullptr, "stale table is rejected");
+            std::remove("test_score_trump_call_table.bin");
+
+            score_trump_call_table::set_current(nullptr);
         }
 
         static void test_006(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            const euchre_card C9(e_suit::CLUBS, e_rank::NINE), CT(e_suit::CLUBS, e_rank::TEN), CA(e_suit::CLUBS, e_rank::ACE);
+            const euchre_card S9(e_suit::SPADES, e_rank::NINE), HJ(e_suit::HEARTS, e_rank::JACK);
+
+            // failing to follow suit marks the player void in the suit lead
+            euchre_perception left(1), partner(2), right(3);
+            for (auto p : {&left, &partner, &right})
+                p->update_after_trump_offer(0, e_trump_decision::CALL_HEARTS);
+
+            left.update_after_card_played(1, S9, C9);
+            ASSERT_TRUE(euchre_mask::contains_all(left.get_cards_not_in_hand_mask(), euchre_mask::suit_mask(e_suit::CLUBS)), "void in clubs");
+            left.reset();
+            left.update_after_trump_offer(0, e_trump_decision::CALL_HEARTS);
+
+            // earlier tricks (each card is its own lead, so nobody is shown void)
+            const std::vector<euchre_card> self_played = {{e_suit::DIAMONDS, e_rank::NINE}, {e_suit::DIAMONDS, e_rank::TEN}, {e_suit::DIAMONDS, e_rank::JACK}};
+            const std::vector<std::pair<euchre_perception *, std::vector<euchre_card>>> others_played = {
+                {&left, {{e_suit::DIAMONDS, e_rank::QUEEN}, {e_suit::DIAMONDS, e_rank::KING}, {e_suit::DIAMONDS, e_rank::ACE}}},
+                {&partner, {{e_suit::SPADES, e_rank::ACE}, {e_suit::SPADES, e_rank::KING}, {e_suit::SPADES, e_rank::QUEEN}}},
+                {&right, {{e_suit::SPADES, e_rank::TEN}, {e_suit::SPADES, e_rank::JACK}, {e_suit::HEARTS, e_rank::NINE}}}};
+
+            for (auto &o : others_played)
+                for (auto &c : o.second)
+                    o.first->update_after_card_played(o.first->seat_index, c, c);
+
+            // in the current trick, partner's ace is winning and this player (last to play) is out of clubs
+            const std::vector<euchre_card> trick = {C9, CA, CT};
+            left.update_after_card_played(1, C9, C9);
+            partner.update_after_card_played(2, CA, C9);
+            right.update_after_card_played(3, CT, C9);
+
+            euchre_hand hand;
+            hand.add_cards({HJ, S9});
+
+            euchre_algo::pimc_settings settings;
+            settings.num_samples = 20;
+
+            // sampling sees that trumping the partner's ace gives away the last trick
+            const euchre_card card = euchre_algo_choose_card_to_play::choose_card(trick, e_suit::HEARTS, hand, euchre_seat_position::SELF, 3, 2, 1, false,
+                                                                                 left, partner, right, self_played, settings);
+            ASSERT_TRUE(card == S9, "throw off instead of trumping partner");
+
+            // games with sampled card play run to completion
+            settings.num_samples = 2;
+            const euchre_simulation_result result = run_simulation(1, 11, settings);
+            ASSERT_TRUE(result.games == 1, "pimc game finished");
         }
 
         static void test_007(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            // every task submitted to the pool runs, including tasks submitted by tasks
+            {
+                std::atomic<int> count{0};
+                {
+                    work_stealing_pool pool(3);
+                    for (int i = 0; i < 100; ++i)
+                        pool.submit([&pool, &count]() {
+                            ++count;
+                            pool.submit([&count]() { ++count; });
+                        });
+                }
+                ASSERT_TRUE(count == 200, "all tasks ran");
+            }
+
+            // a random full deal, seen by seat 0 on lead
+            std::vector<uint8_t> deck(euchre_constants::NUM_CARDS);
+            for (uint8_t i = 0; i < deck.size(); ++i)
+                deck[i] = i;
+            std::shuffle(deck.begin(), deck.end(), get_random_engine());
+
+            euchre_algo::solver_position pos;
+            pos.trump_suit = e_suit::DIAMONDS;
+            for (size_t i = 0; i < euchre_constants::EUCHRE_HAND_SIZE; ++i)
+                pos.hands[0] |= euchre_card_mask(1) << deck[i];
+
+            euchre_algo::deal_constraints constraints;
+            constraints.unseen = euchre_mask::FULL_DECK & ~pos.hands[0];
+            for (uint8_t seat = 1; seat < euchre_constants::NUM_PLAYERS; ++seat)
+            {
+                constraints.counts[seat] = euchre_constants::EUCHRE_HAND_SIZE;
+                constraints.allowed[seat] = constraints.unseen;
+            }
+
+            // sampling on a pool chooses the same card as sampling on the calling thread
+            work_stealing_pool pool(2);
+
+            euchre_algo::pimc_settings settings;
+            settings.num_samples = 16;
+
+            seed_random_engine(5);
+            const euchre_card serial = euchre_algo::choose_card_pimc(pos, constraints, settings);
+
+            settings.pool = &pool;
+            seed_random_engine(5);
+            const euchre_card parallel = euchre_algo::choose_card_pimc(pos, constraints, settings);
+
+            ASSERT_TRUE(serial == parallel, "same card with and without the pool");
+            ASSERT_TRUE(euchre_mask::card_bit(parallel) & pos.hands[0], "card is from the hand");
+
+            // with a time limit, a card is still chosen long before all the samples could be solved
+            settings.num_samples = 1000000;
+            settings.time_limit_ms = 20;
+
+            const auto start = std::chrono::steady_clock::now();
+            const euchre_card timed = euchre_algo::choose_card_pimc(pos, constraints, settings);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            ASSERT_TRUE(euchre_mask::card_bit(timed) & pos.hands[0], "timed card is from the hand");
+            ASSERT_TRUE(seconds < 5.0, "decision is made when time runs out");
         }
 
         static void test_008(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+            using namespace rda::euchre::euchre_algo;
+
+            // six unseen cards: seat 1 holds two (void in spades), seat 2 holds two and is known
+            // to hold the ace of clubs, and the other two are undealt
+            const euchre_card_mask unseen = euchre_mask::suit_mask(e_suit::CLUBS);
+            const euchre_card_mask ace = euchre_mask::card_bit(euchre_card(e_suit::CLUBS, e_rank::ACE));
+
+            deal_constraints small;
+            small.unseen = unseen;
+            small.counts[1] = 2;
+            small.counts[2] = 2;
+            small.allowed[1] = unseen & ~euchre_mask::card_bit(euchre_card(e_suit::CLUBS, e_rank::NINE));
+            small.allowed[2] = unseen;
+            small.required[2] = ace;
+
+            // count the consistent deals by brute force
+            std::map<std::pair<euchre_card_mask, euchre_card_mask>, int> frequency;
+            for (euchre_card_mask a = 0; a <= unseen; ++a)
+                for (euchre_card_mask b = 0; b <= unseen; ++b)
+                    if (euchre_mask::popcount(a) == 2 && euchre_mask::popcount(b) == 2 && !(a & b) &&
+                        euchre_mask::contains_all(small.allowed[1], a) && euchre_mask::contains_all(b, ace))
+                        frequency[{a, b}] = 0;
+
+            const deal_sampler sampler(small);
+            ASSERT_TRUE(sampler.count() == frequency.size(), "counts every consistent deal");
+
+            // every deal is drawn, about equally often
+            const int draws = 200 * static_cast<int>(frequency.size());
+            std::array<euchre_card_mask, euchre_constants::NUM_PLAYERS> hands{};
+
+            for (int i = 0; i < draws; ++i)
+            {
+                ASSERT_TRUE(sampler.sample(get_random_engine(), hands), "sample");
+                ASSERT_TRUE(frequency.count({hands[1], hands[2]}) == 1, "sampled deal is consistent");
+                ++frequency[{hands[1], hands[2]}];
+            }
+
+            for (auto &f : frequency)
+                ASSERT_TRUE(f.second > 120 && f.second < 280, "deals are drawn uniformly");
+
+            // late in a hand with many voids, every sample is still consistent
+            deal_constraints late;
+            late.unseen = euchre_mask::FULL_DECK & ~euchre_mask::suit_mask(e_suit::DIAMONDS);
+            late.counts = {0, 3, 3, 3};
+            late.allowed[1] = late.unseen & ~euchre_mask::suit_mask(e_suit::HEARTS) & ~euchre_mask::suit_mask(e_suit::SPADES);
+            late.allowed[2] = late.unseen & ~euchre_mask::suit_mask(e_suit::CLUBS);
+            late.allowed[3] = late.unseen & ~euchre_mask::suit_mask(e_suit::HEARTS);
+
+            const deal_sampler late_sampler(late);
+            ASSERT_TRUE(late_sampler.is_feasible(), "feasible");
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                late_sampler.sample(get_random_engine(), hands);
+
+                for (uint8_t seat = 1; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                {
+                    ASSERT_TRUE(euchre_mask::popcount(hands[seat]) == 3, "right number of cards");
+                    ASSERT_TRUE(euchre_mask::contains_all(late.allowed[seat], hands[seat]), "only allowed cards");
+                }
+
+                ASSERT_TRUE(!(hands[1] & hands[2]) && !(hands[1] & hands[3]) && !(hands[2] & hands[3]), "no card dealt twice");
+            }
+
+            // no consistent deal: two seats need six cards from five clubs
+            deal_constraints impossible = late;
+            impossible.allowed[1] = euchre_mask::suit_mask(e_suit::CLUBS) & ~ace;
+            impossible.allowed[3] = impossible.allowed[1];
+            ASSERT_FALSE(deal_sampler(impossible).is_feasible(), "infeasible");
+            ASSERT_FALSE(sample_deal(impossible, get_random_engine(), hands), "no sample");
         }
 
         static void test_009(const size_t testNum, TestInput &input)
         {
+            using namespace rda::euchre;
+
+            euchre_deck deck;
+            deck.init();
+            ASSERT_TRUE(deck.size() == euchre_constants::NUM_CARDS, "full deck");
+
+            // deal four hands in packets, then the up card. every card is dealt once.
+            for (int i = 0; i < 100; ++i)
+            {
+                deck.init();
+                deck.shuffle(get_random_engine());
+
+                std::array<euchre_hand, euchre_constants::NUM_PLAYERS> hands;
+                const std::vector<size_t> packets = {3, 2, 3, 2, 2, 3, 2, 3};
+
+                for (size_t p = 0; p < packets.size(); ++p)
+                    deck.deal(hands[p % hands.size()], packets[p]);
+
+                const euchre_card up_card = deck.draw();
+
+                euchre_card_mask dealt = euchre_mask::card_bit(up_card);
+                for (auto &h : hands)
+                {
+                    ASSERT_TRUE(h.size() == euchre_constants::EUCHRE_HAND_SIZE, "five cards each");
+                    ASSERT_TRUE(!(dealt & h.mask()), "no card dealt twice");
+                    dealt |= h.mask();
+                }
+
+                ASSERT_TRUE(euchre_mask::popcount(dealt) == 21, "21 cards dealt");
+                ASSERT_TRUE(deck.size() == 3, "three cards left");
+            }
+
+            // a packet larger than the deck is not dealt, and an empty deck draws an invalid card
+            euchre_hand hand;
+            deck.deal(hand, 4);
+            ASSERT_TRUE(hand.empty() && deck.size() == 3, "packet too large");
+
+            for (int i = 0; i < 3; ++i)
+                deck.draw();
+
+            ASSERT_TRUE(deck.empty(), "deck empty");
+            ASSERT_TRUE(deck.draw() == euchre_card(), "draw from empty deck");
+        }
+
+        static void test_010(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            // the same seed and stream give the same sequence
+            euchre_random_engine a(42), b(42), c(42, 1);
+            for (int i = 0; i < 100; ++i)
+                ASSERT_TRUE(a() == b(), "same sequence");
+            ASSERT_TRUE(a() != c(), "different stream");
+
+            // a split engine and the engine it was split from don't repeat each other
+            euchre_random_engine parent(7);
+            euchre_random_engine child = parent.split();
+            std::vector<uint64_t> from_child, from_parent;
+            for (int i = 0; i < 1000; ++i)
+            {
+                from_child.push_back(child());
+                from_parent.push_back(parent());
+            }
+            std::sort(from_child.begin(), from_child.end());
+            for (auto &v : from_parent)
+                ASSERT_FALSE(std::binary_search(from_child.begin(), from_child.end(), v), "independent streams");
+
+            // values are spread evenly over a small range
+            std::array<int, 6> counts{};
+            std::uniform_int_distribution<int> die(0, 5);
+            for (int i = 0; i < 60000; ++i)
+                ++counts[die(a)];
+            for (auto &n : counts)
+                ASSERT_TRUE(n > 9500 && n < 10500, "uniform");
+
+            // a game seeded the same way plays the same game
+            euchre_game g1(true, 99), g2(true, 99);
+            g1.play_game();
+            g2.play_game();
+            ASSERT_TRUE(g1.get_hands_played() == g2.get_hands_played(), "same hands");
+            ASSERT_TRUE(g1.get_scoreboard().team1_score == g2.get_scoreboard().team1_score, "same score");
+        }
+
+        static void test_011(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            // record the deals of some games, and save them to a file
+            euchre_deal_log recorded;
+            const euchre_simulation_result played = record_games(20, 11, recorded);
+            ASSERT_TRUE(recorded.size() == played.hands, "one deal per hand");
+
+            // every deal has 20 different cards plus a different up card
+            for (size_t i = 0; i < recorded.size(); ++i)
+            {
+                const euchre_deal deal = recorded.get(i);
+                euchre_card_mask seen = euchre_mask::card_bit(deal.up_card);
+
+                for (auto &hand : deal.hands)
+                    for (auto &card : hand)
+                        seen |= euchre_mask::card_bit(card);
+
+                ASSERT_TRUE(euchre_mask::popcount(seen) == 21 && deal.dealer_index < euchre_constants::NUM_PLAYERS, "valid deal");
+            }
+
+            ASSERT_TRUE(recorded.save("test_euchre_deals.bin"), "save deals");
+
+            euchre_deal_log loaded;
+            ASSERT_TRUE(loaded.load("test_euchre_deals.bin") && loaded.size() == recorded.size(), "load deals");
+
+            // replaying the deals with the same seed plays the same games
+            const euchre_simulation_result replayed = replay_games(20, 11, loaded);
+            ASSERT_TRUE(replayed.hands == played.hands && replayed.team1_points == played.team1_points &&
+                            replayed.team2_points == played.team2_points,
+                        "same games");
+
+            // with another seed the players decide differently, but are dealt the same cards
+            euchre_deal_log rerecorded;
+            euchre_game game(true, 12);
+            game.set_deal_source(&loaded);
+            game.set_deal_recorder(&rerecorded);
+            game.play_game();
+
+            for (size_t i = 0; i < rerecorded.size(); ++i)
+            {
+                const euchre_deal a = loaded.get(i), b = rerecorded.get(i);
+                ASSERT_TRUE(a.dealer_index == b.dealer_index && a.up_card == b.up_card && a.hands == b.hands, "same deal");
+            }
+
+            // a truncated or foreign file is rejected
+            rda::fileio f("test_euchre_deals.bin");
+            ASSERT_TRUE(f.read() && f.truncate(f.size() - 1) && f.write(), "truncate");
+            ASSERT_FALSE(loaded.load("test_euchre_deals.bin") || !loaded.empty(), "truncated file");
+            ASSERT_FALSE(loaded.load("test_score_trump_call_table.bin"), "missing file");
+
+            std::remove("test_euchre_deals.bin");
+        }
+
+        static void test_012(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            const euchre_deal_log deals = make_random_deals(40, 5);
+            ASSERT_TRUE(deals.size() == 40, "boards dealt");
+
+            // the same way of playing against itself breaks even on every board
+            const euchre_duplicate_result even = run_duplicate_tournament(deals, 5, euchre_algo::pimc_settings(), euchre_algo::pimc_settings(), 3);
+            ASSERT_TRUE(even.a_points == even.b_points && even.mean == 0.0f && even.std_error == 0.0f, "even match");
+            ASSERT_TRUE(even.unpaired_std_error > 0.0f, "card luck");
+
+            // the result does not depend on the number of threads
+            euchre_algo::pimc_settings sampling;
+            sampling.num_samples = 8;
+
+            const euchre_deal_log few_deals = make_random_deals(12, 5);
+            const euchre_duplicate_result one = run_duplicate_tournament(few_deals, 5, sampling, euchre_algo::pimc_settings(), 1);
+            const euchre_duplicate_result two = run_duplicate_tournament(few_deals, 5, sampling, euchre_algo::pimc_settings(), 2);
+            ASSERT_TRUE(one.a_points == two.a_points && one.b_points == two.b_points && one.mean == two.mean, "same result");
+            ASSERT_TRUE(one.ci95_low() <= one.mean && one.mean <= one.ci95_high(), "interval");
+        }
+
+        // player that plays the first card in its hand that follows suit, and counts its plays
+        class test_first_card_player final : public rda::euchre::euchre_player
+        {
+        public:
+            // number of cards chosen
+            uint32_t cards_chosen = 0;
+
+            test_first_card_player(const uint8_t seat_index)
+                : euchre_player(seat_index)
+            {
+            }
+
+        protected:
+            rda::euchre::euchre_card choose_card(const std::vector<rda::euchre::euchre_card> &cards_played,
+                                                 const uint8_t,
+                                                 const bool,
+                                                 const uint8_t,
+                                                 const uint8_t,
+                                                 const uint8_t) override
+            {
+                using namespace rda::euchre;
+
+                ++cards_chosen;
+
+                if (!cards_played.empty())
+                {
+                    const e_suit suit_lead = euchre_algo::get_effective_suit(cards_played.front(), m_suit_called_trump);
+
+                    for (auto iter = m_hand.cbegin(); iter != m_hand.cend(); ++iter)
+                        if (euchre_algo::get_effective_suit(*iter, m_suit_called_trump) == suit_lead)
+                            return *iter;
+                }
+
+                return *m_hand.cbegin();
+            }
+        };
+
+        // player that always tries to play a card it doesn't hold
+        class test_invalid_card_player final : public rda::euchre::euchre_player
+        {
+        public:
+            test_invalid_card_player(const uint8_t seat_index)
+                : euchre_player(seat_index)
+            {
+            }
+
+        protected:
+            rda::euchre::euchre_card choose_card(const std::vector<rda::euchre::euchre_card> &,
+                                                 const uint8_t,
+                                                 const bool,
+                                                 const uint8_t,
+                                                 const uint8_t,
+                                                 const uint8_t) override
+            {
+                return rda::euchre::euchre_card();
+            }
+        };
+
+        static void test_013(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            // each seat keeps its own player type
+            euchre_game table(true, 1);
+            ASSERT_TRUE(typeid(table.get_player(0)) == typeid(euchre_player_human), "human seat");
+            ASSERT_TRUE(typeid(table.get_player(1)) == typeid(euchre_player_computer), "computer seat");
+
+            // a strategy overriding the card choice is the one asked to play
+            basic_euchre_game<test_first_card_player, euchre_player_computer, euchre_player_computer, euchre_player_computer> game(true, 4);
+            game.play_game();
+            ASSERT_TRUE(game.get_scoreboard().is_over(), "game is over");
+            ASSERT_TRUE(game.get_player<0>().cards_chosen > 0, "strategy dispatched");
+
+            // a card that may not be played is replaced by one that may
+            basic_euchre_game<test_invalid_card_player, euchre_player_computer, test_invalid_card_player, euchre_player_computer> cheats(true, 4);
+            cheats.play_game();
+            ASSERT_TRUE(cheats.get_scoreboard().is_over(), "illegal cards replaced");
+
+            // four computer players play the same games as the table game, whose human seat
+            // plays like a computer
+            euchre_computer_game computers(true, 4);
+            euchre_game humans(true, 4);
+            computers.play_game();
+            humans.play_game();
+            ASSERT_TRUE(computers.get_hands_played() == humans.get_hands_played() &&
+                            computers.get_scoreboard().team1_score == humans.get_scoreboard().team1_score,
+                        "same games");
+        }
+
+        static void test_014(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            // card ids round trip, and decode to the suit, rank and color they were built from
+            for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+            {
+                for (auto r = e_rank::BEGIN; r != e_rank::END; ++r)
+                {
+                    const euchre_card c(s, r);
+                    ASSERT_TRUE(c.id() < euchre_constants::NUM_CARDS && euchre_card::from_id(c.id()) == c, "id round trip");
+                    ASSERT_TRUE(c.suit() == s && c.rank() == r, "decoded suit and rank");
+                    ASSERT_TRUE(c.color() == ((s == e_suit::CLUBS || s == e_suit::SPADES) ? e_color::BLACK : e_color::RED), "decoded color");
+                    ASSERT_TRUE(c.to_string() == "[" + to_string(r) + to_string(s) + "]", "card name");
+                }
+            }
+
+            // a bad suit, rank or id is the invalid card
+            ASSERT_TRUE(euchre_card(e_suit::INVALID, e_rank::ACE) == euchre_card(), "invalid suit");
+            ASSERT_TRUE(euchre_card(e_suit::HEARTS, e_rank::INVALID) == euchre_card(), "invalid rank");
+            ASSERT_TRUE(euchre_card::from_id(200) == euchre_card(), "invalid id");
+            ASSERT_TRUE(euchre_card().suit() == e_suit::INVALID && euchre_card().color() == e_color::INVALID, "invalid decode");
+            ASSERT_TRUE(euchre_card().to_string() == "[XX]", "invalid name");
+        }
+
+        static void test_015(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            // weights written to a json file read back the same, and other keys are kept
+            rda::fileio f("test_euchre_weights.json");
+            ASSERT_TRUE(f.set("{\"other\": 7, \"trump_call\": {\"have_ace_trump\": 1.0}}") && f.write(), "write file");
+
+            score_trump_call_weights weights = *score_trump_call_weights::current();
+            weights.set(e_trump_call_term::HAVE_ACE_TRUMP, 5.25f);
+            ASSERT_TRUE(weights.save_file("test_euchre_weights.json"), "save weights");
+
+            score_trump_call_weights loaded;
+            ASSERT_TRUE(loaded.load_file("test_euchre_weights.json") && loaded.values == weights.values, "load weights");
+
+            rda::fileio saved("test_euchre_weights.json");
+            ASSERT_TRUE(saved.read() && rda::json::parse(saved.to_string())->get_integer_by_path("other") == 7, "other keys kept");
+            std::remove("test_euchre_weights.json");
+
+            // players that never call trump lose to the current weights
+            score_trump_call_weights timid = *score_trump_call_weights::current();
+            timid.set(e_trump_call_term::TRUMP_CALL_THRESHOLD, 1000.0f);
+            timid.set(e_trump_call_term::LONER_CALL_THRESHOLD, 1000.0f);
+
+            const euchre_deal_log deals = make_random_deals(40, 6);
+            const euchre_contender current{euchre_algo::pimc_settings(), nullptr};
+            const euchre_contender never{euchre_algo::pimc_settings(), std::make_shared<const score_trump_call_weights>(timid)};
+            ASSERT_TRUE(run_duplicate_tournament(deals, 6, never, current, 2).mean < 0.0f, "timid weights lose");
+
+            // a short tuning run keeps the best candidate first, and resumes from its checkpoint
+            score_trump_call_tuner_settings settings;
+            settings.generations = 2;
+            settings.population = 4;
+            settings.elites = 2;
+            settings.boards = 20;
+            settings.num_threads = 2;
+            settings.seed = 3;
+            settings.checkpoint_path = "test_euchre_tuner.checkpoint";
+
+            std::remove(settings.checkpoint_path.c_str());
+
+            const score_trump_call_tuner_state first = score_trump_call_tuner::run(timid, settings);
+            ASSERT_TRUE(first.generation == 2 && first.population.size() == 4, "generations run");
+            ASSERT_TRUE(first.best.fitness >= 0.0f && first.population.front().weights.values == first.best.weights.values, "best kept");
+
+            settings.generations = 3;
+            const score_trump_call_tuner_state resumed = score_trump_call_tuner::run(timid, settings);
+            ASSERT_TRUE(resumed.generation == 3 && resumed.population.size() == 4, "resumed");
+
+            std::remove(settings.checkpoint_path.c_str());
+        }
+
+        static void test_016(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            // random weights, so every term counts
+            euchre_random_engine engine(16);
+            std::uniform_real_distribution<double> weight(-10.0f, 10.0f);
+
+            auto weights = std::make_shared<score_trump_call_weights>();
+            for (auto &w : weights->values)
+                w = weight(engine);
+
+            score_trump_call_batch batch;
+            std::vector<euchre_card_mask> hands;
+
+            euchre_deck deck;
+            for (int i = 0; i < 500; ++i)
+            {
+                deck.init();
+                deck.shuffle(engine);
+
+                euchre_hand hand;
+                deck.deal(hand, euchre_constants::EUCHRE_HAND_SIZE);
+
+                batch.add(hand.mask());
+                hands.push_back(hand.mask());
+            }
+
+            batch.score(*weights);
+            ASSERT_TRUE(batch.size() == hands.size(), "batch size");
+
+            // the batch scores match the hand terms scored one context at a time
+            const euchre_perception left(1), partner(2), right(3);
+            std::vector<double> totals(hands.size());
+
+            for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+            {
+                score_trump_call::score_hand_terms_batch(*weights, s, hands.data(), hands.size(), totals.data());
+
+                for (size_t i = 0; i < hands.size(); ++i)
+                {
+                    euchre_hand hand;
+                    for (euchre_card_mask bits = hands[i]; bits != 0; bits &= bits - 1)
+                        hand.add_card(euchre_mask::card_from_index(euchre_mask::lowest_index(bits)));
+
+                    const score_trump_call_context ctx(*weights, s, hand, euchre_card(), false, euchre_seat_position::INVALID, left, partner, right);
+                    const double expected = score_trump_call::score_hand_terms(ctx);
+
+                    ASSERT_TRUE(totals[i] == expected, "double batch is exact");
+                    ASSERT_TRUE(std::abs(batch.get(i, s) - expected) < 1e-3, "float batch");
+                }
+            }
+
+            batch.clear();
+            ASSERT_TRUE(batch.size() == 0 && batch.scores(e_suit::CLUBS).empty(), "clear");
+        }
+
+        static void test_017(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            // the dealer is about to pick up the king of hearts, and the partner passed on it
+            euchre_hand hand;
+            hand.add_cards({{e_suit::HEARTS, e_rank::JACK}, {e_suit::DIAMONDS, e_rank::JACK}, {e_suit::HEARTS, e_rank::ACE}, {e_suit::CLUBS, e_rank::NINE}, {e_suit::SPADES, e_rank::ACE}});
+
+            euchre_perception left(1), partner(2), right(3);
+            partner.up_card_offer_decision = e_trump_decision::PASS;
+
+            // every weight is 1, so each score counts the features that are set
+            auto ones = std::make_shared<score_trump_call_weights>();
+            for (auto &w : ones->values)
+                w = 1.0f;
+
+            const score_trump_call_context ctx(*ones, e_suit::HEARTS, hand, euchre_card(e_suit::HEARTS, e_rank::KING), false, euchre_seat_position::SELF, left, partner, right);
+            const score_trump_call_features f = score_trump_call::extract_features(ctx);
+
+            const auto has = [&](const e_trump_call_term t) { return f[static_cast<size_t>(t)] == 1.0f; };
+
+            ASSERT_TRUE(has(e_trump_call_term::HAVE_RIGHT_BOWER_TRUMP) && has(e_trump_call_term::HAVE_LEFT_BOWER_TRUMP) && has(e_trump_call_term::HAVE_ACE_TRUMP), "trump held");
+            ASSERT_TRUE(!has(e_trump_call_term::HAVE_KING_TRUMP) && !has(e_trump_call_term::HAVE_NINE_TRUMP), "trump not held");
+            ASSERT_TRUE(has(e_trump_call_term::WOULD_PICK_UP_KING_TRUMP) && !has(e_trump_call_term::PARTNER_WOULD_PICK_UP_KING_TRUMP), "pick up");
+            ASSERT_TRUE(has(e_trump_call_term::HAVE_FOUR_SUITED) && has(e_trump_call_term::HAVE_ONE_NON_TRUMP_WINNERS), "shape");
+            ASSERT_TRUE(has(e_trump_call_term::PARTNER_PASSED_ON_UP_CARD) && !has(e_trump_call_term::ONE_OPPONENT_PASSED_ON_UP_CARD), "passes");
+            ASSERT_TRUE(!has(e_trump_call_term::TRUMP_CALL_THRESHOLD) && !has(e_trump_call_term::LONER_CALL_THRESHOLD), "thresholds are not features");
+
+            // the dot product splits into the hand and situation terms
+            ASSERT_TRUE(score_trump_call::dot(f, *ones, e_trump_call_terms::HAND) == 5.0f, "hand terms");
+            ASSERT_TRUE(score_trump_call::dot(f, *ones, e_trump_call_terms::SITUATION) == 2.0f, "situation terms");
+            ASSERT_TRUE(score_trump_call::dot(f, *ones) == 7.0f, "all terms");
+            ASSERT_TRUE(score_trump_call::score(ones, e_suit::HEARTS, hand, euchre_card(e_suit::HEARTS, e_rank::KING), false, euchre_seat_position::SELF, left, partner, right).get_total_score() == 7.0f, "score");
+        }
+
+        static void test_018(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            euchre_random_engine engine(18);
+            euchre_deck deck;
+
+            euchre_perception left(1), partner(2), right(3);
+            left.up_card_offer_decision = e_trump_decision::PASS;
+            partner.up_card_offer_decision = e_trump_decision::PASS;
+
+            const auto weights = score_trump_call_weights::current();
+
+            // every suit scored in one pass matches scoring the suits one at a time, with and
+            // without the table of hand terms
+            for (int table = 0; table < 2; ++table)
+            {
+                if (table == 1)
+                    score_trump_call::enable_table();
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    deck.init();
+                    deck.shuffle(engine);
+
+                    euchre_hand hand;
+                    deck.deal(hand, euchre_constants::EUCHRE_HAND_SIZE);
+
+                    const euchre_card up_card = deck.draw();
+                    const bool turned_down = (i % 2) == 1;
+                    const euchre_seat_position dealer = static_cast<euchre_seat_position>(i % 4);
+
+                    const score_trump_call::suit_scores scores = score_trump_call::score_suits(weights, hand, up_card, turned_down, dealer, left, partner, right);
+
+                    for (auto s = e_suit::BEGIN; s != e_suit::END; ++s)
+                        ASSERT_TRUE(scores[static_cast<size_t>(s)] == score_trump_call::score(weights, s, hand, up_card, turned_down, dealer, left, partner, right).get_total_score(), "suit score");
+                }
+            }
+
+            score_trump_call_table::set_current(nullptr);
+        }
+
+        static void test_019(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+
+            euchre_hand hand;
+            hand.add_cards({{e_suit::SPADES, e_rank::JACK}, {e_suit::CLUBS, e_rank::JACK}, {e_suit::SPADES, e_rank::ACE}, {e_suit::HEARTS, e_rank::ACE}, {e_suit::HEARTS, e_rank::KING}});
+
+            euchre_perception left(1), partner(2), right(3);
+            left.up_card_offer_decision = e_trump_decision::PASS;
+            partner.up_card_offer_decision = e_trump_decision::PASS;
+
+            const auto weights = score_trump_call_weights::current();
+            const euchre_card up_card(e_suit::SPADES, e_rank::NINE);
+
+            const score_trump_call_context ctx = score_trump_call::score(weights, e_suit::SPADES, hand, up_card, false, euchre_seat_position::RIGHT, left, partner, right);
+
+            // the context is a snapshot of the game state it was scored from
+            ASSERT_TRUE(ctx.m_hand == hand.mask() && ctx.get_hand_size() == 5, "hand");
+            ASSERT_TRUE(ctx.m_partner_passed_on_up_card && ctx.m_num_opponents_passed_on_up_card == 1, "passes");
+            ASSERT_TRUE(ctx.m_num_suits == 3 && ctx.m_num_non_trump_winners == 2, "shape");
+            ASSERT_TRUE(&ctx.get_weights() == weights.get(), "weights are referenced");
+
+            // a copy is unaffected by later changes to the hand and perceptions
+            const score_trump_call_context copy = ctx;
+
+            hand.remove_card({e_suit::HEARTS, e_rank::KING});
+            partner.up_card_offer_decision = e_trump_decision::INVALID;
+
+            ASSERT_TRUE(copy.m_hand != hand.mask() && copy.m_partner_passed_on_up_card, "snapshot");
+            ASSERT_TRUE(copy.get_total_score() == ctx.get_total_score(), "copied score");
         }
 
         static void run_tests()
@@ -115,6 +972,16 @@ namespace rda
             test_vec.push_back(test_007);
             test_vec.push_back(test_008);
             test_vec.push_back(test_009);
+            test_vec.push_back(test_010);
+            test_vec.push_back(test_011);
+            test_vec.push_back(test_012);
+            test_vec.push_back(test_013);
+            test_vec.push_back(test_014);
+            test_vec.push_back(test_015);
+            test_vec.push_back(test_016);
+            test_vec.push_back(test_017);
+            test_vec.push_back(test_018);
+            test_vec.push_back(test_019);
 
             // run each unit test
             for (size_t i = 0; i < test_vec.size(); ++i)
@@ -7,6 +7,7 @@
 //
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <iostream>
 #include <random>
@@ -18,6 +19,7 @@
 #include "../platform_defs.h"
 #include "../euchre_algo_card_sorter.h"
 #include "../euchre_card.h"
+#include "../euchre_card_mask.h"
 #include "../euchre_card_suit.h"
 #include "../euchre_card_rank.h"
 #include "../random_seeder.h"
@@ -196,8 +198,7 @@ namespace rda
             using namespace rda::euchre;
 
             auto deck = get_full_deck(e_suit::HEARTS);
-            seed_randomizer();
-            std::random_shuffle(deck.begin(), deck.end());
+            std::shuffle(deck.begin(), deck.end(), get_random_engine());
 
             sort_deck_by_suit(deck, e_suit::HEARTS);
 
@@ -238,8 +239,7 @@ namespace rda
             using namespace rda::euchre;
 
             auto deck = get_full_deck(e_suit::SPADES);
-            seed_randomizer();
-            std::random_shuffle(deck.begin(), deck.end());
+            std::shuffle(deck.begin(), deck.end(), get_random_engine());
 
             // highest card of trump suit is jack of trump
             auto card = highest_card_in_deck(deck, e_suit::SPADES, e_suit::SPADES);
@@ -258,6 +258,142 @@ namespace rda
             ASSERT_TRUE(card == euchre_card{e_suit::CLUBS, e_rank::KING});
         }
 
+        static void test_011(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre::euchre_algo;
+            using namespace rda::euchre;
+
+            // highest card of the suit lead wins when no trump is played
+            ASSERT_TRUE(trick_winner({{e_suit::CLUBS, e_rank::TEN}, {e_suit::CLUBS, e_rank::ACE}, {e_suit::HEARTS, e_rank::ACE}, {e_suit::CLUBS, e_rank::NINE}}, e_suit::SPADES) == 1);
+
+            // any trump beats the suit lead
+            ASSERT_TRUE(trick_winner({{e_suit::CLUBS, e_rank::ACE}, {e_suit::SPADES, e_rank::NINE}, {e_suit::CLUBS, e_rank::KING}}, e_suit::SPADES) == 1);
+
+            // left bower beats the ace of trump, right bower beats the left bower
+            ASSERT_TRUE(trick_winner({{e_suit::HEARTS, e_rank::ACE}, {e_suit::DIAMONDS, e_rank::JACK}}, e_suit::HEARTS) == 1);
+            ASSERT_TRUE(trick_winner({{e_suit::DIAMONDS, e_rank::JACK}, {e_suit::HEARTS, e_rank::JACK}, {e_suit::HEARTS, e_rank::ACE}}, e_suit::HEARTS) == 1);
+
+            // left bower lead counts as trump, not its printed suit
+            ASSERT_TRUE(trick_winner({{e_suit::DIAMONDS, e_rank::JACK}, {e_suit::DIAMONDS, e_rank::ACE}}, e_suit::HEARTS) == 0);
+        }
+
+        static void test_012(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre::euchre_algo;
+            using namespace rda::euchre;
+
+            const auto bit = [](const e_suit s, const e_rank r) { return euchre_mask::card_bit(euchre_card{s, r}); };
+
+            // trump cards have powers in the order of the sorted trump deck, above every other card
+            for (auto trump = e_suit::BEGIN; trump != e_suit::END; ++trump)
+            {
+                const trick_table &table = get_trick_table(trump);
+                const auto deck = get_full_deck(trump);
+
+                for (auto lead = e_suit::BEGIN; lead != e_suit::END; ++lead)
+                    for (size_t i = 1; i < 7; ++i)
+                        ASSERT_TRUE(table.power[static_cast<uint8_t>(lead)][euchre_mask::card_index(deck[i - 1])] >
+                                    table.power[static_cast<uint8_t>(lead)][euchre_mask::card_index(deck[i])]);
+
+                ASSERT_TRUE(table.suit_cards[static_cast<uint8_t>(trump)] == euchre_mask::trump_mask(trump));
+            }
+
+            // the left bower follows trump, not its printed suit
+            const euchre_card_mask hand = bit(e_suit::DIAMONDS, e_rank::JACK) | bit(e_suit::DIAMONDS, e_rank::ACE) | bit(e_suit::CLUBS, e_rank::NINE);
+            const trick_table &hearts = get_trick_table(e_suit::HEARTS);
+
+            ASSERT_TRUE(legal_moves(hearts, hand, euchre_mask::card_index(euchre_card{e_suit::HEARTS, e_rank::NINE})) == bit(e_suit::DIAMONDS, e_rank::JACK));
+            ASSERT_TRUE(legal_moves(hearts, hand, euchre_mask::card_index(euchre_card{e_suit::DIAMONDS, e_rank::KING})) == bit(e_suit::DIAMONDS, e_rank::ACE));
+            ASSERT_TRUE(legal_moves(hearts, hand, euchre_mask::card_index(euchre_card{e_suit::SPADES, e_rank::KING})) == hand);
+            ASSERT_TRUE(legal_moves(hearts, hand, euchre_constants::NUM_CARDS) == hand);
+
+            // a trick keeps track of its winner as cards are played
+            euchre_trick trick(e_suit::HEARTS);
+            trick.play(2, euchre_card{e_suit::DIAMONDS, e_rank::KING});
+            ASSERT_TRUE(trick.lead_suit() == e_suit::DIAMONDS && trick.winning_seat() == 2);
+            trick.play(3, euchre_card{e_suit::DIAMONDS, e_rank::ACE});
+            ASSERT_TRUE(trick.winning_seat() == 3);
+            trick.play(0, euchre_card{e_suit::CLUBS, e_rank::ACE});
+            ASSERT_TRUE(trick.winning_seat() == 3);
+            trick.play(1, euchre_card{e_suit::DIAMONDS, e_rank::JACK});
+            ASSERT_TRUE(trick.winning_seat() == 1 && trick.winning_position() == 3 && trick.size() == 4);
+
+            // with no trump, only the suit lead can win
+            euchre_trick no_trump(e_suit::INVALID);
+            no_trump.play(0, euchre_card{e_suit::CLUBS, e_rank::JACK});
+            no_trump.play(1, euchre_card{e_suit::SPADES, e_rank::JACK});
+            no_trump.play(2, euchre_card{e_suit::CLUBS, e_rank::QUEEN});
+            ASSERT_TRUE(no_trump.winning_seat() == 2);
+        }
+
+        static void test_013(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre::euchre_algo;
+            using namespace rda::euchre;
+
+            // sorting any order of the deck gives the sorted full deck, for every trump suit
+            rda::euchre::euchre_random_engine engine(13);
+
+            for (auto trump = e_suit::BEGIN; trump != e_suit::END; ++trump)
+            {
+                const auto sorted = get_full_deck(trump);
+
+                for (int i = 0; i < 10; ++i)
+                {
+                    auto deck = sorted;
+                    std::shuffle(deck.begin(), deck.end(), engine);
+                    sort_deck_by_suit(deck, trump);
+                    ASSERT_TRUE(deck == sorted, "sorted deck");
+                }
+
+                for (uint8_t n = 0; n < euchre_constants::NUM_CARDS; ++n)
+                    ASSERT_TRUE(sort_position(sorted[n], trump) == n, "sort position");
+            }
+
+            // with no trump, suits sort in suit order from the ace down, jacks included
+            ASSERT_TRUE(sort_position(euchre_card{e_suit::CLUBS, e_rank::ACE}, e_suit::INVALID) == 0);
+            ASSERT_TRUE(sort_position(euchre_card{e_suit::CLUBS, e_rank::JACK}, e_suit::INVALID) == 3);
+            ASSERT_TRUE(sort_position(euchre_card{e_suit::SPADES, e_rank::NINE}, e_suit::INVALID) == 23);
+
+            // suits are counted by effective suit
+            const deck_metrics dm(e_suit::HEARTS, {{e_suit::DIAMONDS, e_rank::JACK}, {e_suit::HEARTS, e_rank::NINE}, {e_suit::CLUBS, e_rank::NINE}});
+            ASSERT_TRUE(dm.suit_counts[static_cast<uint8_t>(e_suit::HEARTS)] == 2 && dm.suit_counts[static_cast<uint8_t>(e_suit::DIAMONDS)] == 0);
+        }
+
+        static void test_014(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre::euchre_algo;
+            using namespace rda::euchre;
+
+            // the highest card of a mask is the one that sorts first, for random sets of cards
+            rda::euchre::euchre_random_engine engine(14);
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                const euchre_card_mask cards = static_cast<euchre_card_mask>(engine()) & euchre_mask::FULL_DECK;
+                const e_suit trump = static_cast<e_suit>(i % 5);
+
+                uint8_t first = euchre_constants::NUM_CARDS;
+                for (uint8_t index = 0; index < euchre_constants::NUM_CARDS; ++index)
+                    if (cards & (euchre_card_mask(1) << index))
+                        first = std::min(first, sort_position(euchre_mask::card_from_index(index), trump));
+
+                const euchre_card expected = (first < euchre_constants::NUM_CARDS) ? euchre_mask::card_from_index(CARD_ORDER.card[card_order_row(trump)][first]) : euchre_card();
+                ASSERT_TRUE(highest_card(cards, trump) == expected, "highest card");
+
+                std::array<euchre_card, euchre_constants::NUM_CARDS> sorted;
+                const uint8_t count = sorted_cards(cards, trump, sorted);
+                ASSERT_TRUE(count == euchre_mask::popcount(cards) && (count == 0 || sorted[0] == expected), "sorted cards");
+            }
+
+            // cards of a suit follow the effective suit, minus the excluded cards
+            const euchre_card_mask hand = deck_mask({{e_suit::DIAMONDS, e_rank::JACK}, {e_suit::DIAMONDS, e_rank::ACE}, {e_suit::HEARTS, e_rank::NINE}});
+            ASSERT_TRUE(cards_of_suit(hand, e_suit::HEARTS, e_suit::HEARTS) == deck_mask({{e_suit::DIAMONDS, e_rank::JACK}, {e_suit::HEARTS, e_rank::NINE}}));
+            ASSERT_TRUE(cards_of_suit(hand, e_suit::DIAMONDS, e_suit::HEARTS) == deck_mask({{e_suit::DIAMONDS, e_rank::ACE}}));
+            ASSERT_TRUE(cards_of_suit(hand, e_suit::DIAMONDS, e_suit::CLUBS, deck_mask({{e_suit::DIAMONDS, e_rank::ACE}})) == deck_mask({{e_suit::DIAMONDS, e_rank::JACK}}));
+            ASSERT_TRUE(highest_card(euchre_mask::EMPTY, e_suit::CLUBS) == euchre_card());
+        }
+
         static void run_tests()
         {
             // vector to hold functions to unit tests
@@ -275,6 +411,10 @@ namespace rda
             test_vec.push_back(test_008);
             test_vec.push_back(test_009);
             test_vec.push_back(test_010);
+            test_vec.push_back(test_011);
+            test_vec.push_back(test_012);
+            test_vec.push_back(test_013);
+            test_vec.push_back(test_014);
 
             // run each unit test
             for (size_t i = 0; i < test_vec.size(); ++i)
@@ -0,0 +1,277 @@
+#pragma once
+
+//
+// test_euchre_algo_solver.h - Unit tests for euchre_algo_solver.h.
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "unit_test_utils.h"
+
+#include "../platform_defs.h"
+#include "../euchre_algo_card_sorter.h"
+#include "../euchre_algo_solver.h"
+#include "../euchre_card.h"
+#include "../euchre_card_mask.h"
+#include "../random_seeder.h"
+
+PUSH_WARN_DISABLE
+WARN_DISABLE(4100, "-Wunused-parameter")
+
+namespace rda
+{
+    namespace test_euchre_algo_solver
+    {
+        using unit_test_utils::ASSERT_FALSE;
+        using unit_test_utils::ASSERT_NO_THROW;
+        using unit_test_utils::ASSERT_THROWS;
+        using unit_test_utils::ASSERT_THROWS_OUT_OF_RANGE;
+        using unit_test_utils::ASSERT_TRUE;
+
+        struct TestInput
+        {
+        };
+
+        static void setup(const size_t testNum, TestInput &input)
+        {
+            std::cout << "Running euchre_algo_solver test: " << testNum << std::endl;
+        }
+
+        static void teardown(const size_t testNum, TestInput &input)
+        {
+        }
+
+        // build a mask from a list of cards
+        static rda::euchre::euchre_card_mask to_mask(const std::vector<rda::euchre::euchre_card> &cards)
+        {
+            rda::euchre::euchre_card_mask m = 0;
+            for (auto &c : cards)
+                m |= rda::euchre::euchre_mask::card_bit(c);
+            return m;
+        }
+
+        // plain minimax (no pruning) over the same rules, for checking the solver
+        static int brute_force(rda::euchre::euchre_algo::solver_position pos, const uint8_t team)
+        {
+            using namespace rda::euchre;
+
+            const uint8_t seat = pos.seat_to_play();
+            const euchre_card_mask hand = pos.hands[seat];
+
+            if (hand == 0)
+                return 0;
+
+            euchre_card_mask moves = hand;
+            if (pos.num_played > 0)
+            {
+                const e_suit lead = euchre_algo::get_effective_suit(euchre_mask::card_from_index(pos.played[0]), pos.trump_suit);
+                const euchre_card_mask follow = hand & euchre_mask::effective_suit_mask(lead, pos.trump_suit);
+                if (follow)
+                    moves = follow;
+            }
+
+            const bool maximizing = (seat % 2 == team);
+            int best = maximizing ? -1 : 100;
+
+            for (uint8_t i = 0; i < euchre_constants::NUM_CARDS; ++i)
+            {
+                if (!(moves & (1u << i)))
+                    continue;
+
+                euchre_algo::solver_position next = pos;
+                next.play(euchre_mask::card_from_index(i));
+
+                int value = 0;
+                if (next.num_played == next.players_per_trick())
+                {
+                    std::vector<euchre_card> trick;
+                    for (uint8_t n = 0; n < next.num_played; ++n)
+                        trick.push_back(euchre_mask::card_from_index(next.played[n]));
+
+                    const uint8_t winner = next.seat_of_play(static_cast<uint8_t>(euchre_algo::trick_winner(trick, next.trump_suit)));
+                    value = (winner % 2 == team) ? 1 : 0;
+
+                    next.leader_index = winner;
+                    next.num_played = 0;
+                }
+
+                value += brute_force(next, team);
+
+                best = maximizing ? std::max(best, value) : std::min(best, value);
+            }
+
+            return best;
+        }
+
+        // deal n cards to each seat from a shuffled deck
+        static rda::euchre::euchre_algo::solver_position random_position(const size_t n, const rda::euchre::e_suit trump)
+        {
+            using namespace rda::euchre;
+
+            std::vector<uint8_t> deck(euchre_constants::NUM_CARDS);
+            for (uint8_t i = 0; i < deck.size(); ++i)
+                deck[i] = i;
+            std::shuffle(deck.begin(), deck.end(), get_random_engine());
+
+            euchre_algo::solver_position pos;
+            pos.trump_suit = trump;
+
+            for (size_t seat = 0; seat < euchre_constants::NUM_PLAYERS; ++seat)
+                for (size_t i = 0; i < n; ++i)
+                    pos.hands[seat] |= euchre_card_mask(1) << deck[seat * n + i];
+
+            return pos;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////////
+
+        static void test_000(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+            using namespace rda::euchre::euchre_algo;
+
+            // five top trumps take every trick
+            solver_position pos;
+            pos.trump_suit = e_suit::HEARTS;
+            pos.hands[0] = to_mask({{e_suit::HEARTS, e_rank::JACK}, {e_suit::DIAMONDS, e_rank::JACK}, {e_suit::HEARTS, e_rank::ACE}, {e_suit::HEARTS, e_rank::KING}, {e_suit::HEARTS, e_rank::QUEEN}});
+            pos.hands[1] = to_mask({{e_suit::HEARTS, e_rank::TEN}, {e_suit::HEARTS, e_rank::NINE}, {e_suit::CLUBS, e_rank::ACE}, {e_suit::CLUBS, e_rank::KING}, {e_suit::CLUBS, e_rank::QUEEN}});
+            pos.hands[2] = to_mask({{e_suit::SPADES, e_rank::ACE}, {e_suit::SPADES, e_rank::KING}, {e_suit::SPADES, e_rank::QUEEN}, {e_suit::SPADES, e_rank::JACK}, {e_suit::SPADES, e_rank::TEN}});
+            pos.hands[3] = to_mask({{e_suit::DIAMONDS, e_rank::ACE}, {e_suit::DIAMONDS, e_rank::KING}, {e_suit::DIAMONDS, e_rank::QUEEN}, {e_suit::DIAMONDS, e_rank::TEN}, {e_suit::DIAMONDS, e_rank::NINE}});
+            pos.leader_index = 0;
+
+            ASSERT_TRUE(solve_double_dummy(pos, 0) == 5, "top trumps take all tricks");
+            ASSERT_TRUE(solve_double_dummy(pos, 1) == 0, "opponents take no tricks");
+        }
+
+        static void test_001(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+            using namespace rda::euchre::euchre_algo;
+
+            // solver agrees with plain minimax on small random deals
+            for (int i = 0; i < 200; ++i)
+            {
+                solver_position pos = random_position(3, static_cast<e_suit>(i % 4));
+                pos.leader_index = static_cast<uint8_t>(i % 4);
+
+                if (i % 3 == 0)
+                    pos.sitting_out_index = static_cast<uint8_t>((i + 1) % 4);
+
+                if (pos.seat_to_play() == pos.sitting_out_index)
+                    pos.leader_index = pos.seat_after(pos.leader_index);
+
+                for (uint8_t seat = 0; seat < 2; ++seat)
+                    ASSERT_TRUE(solve_double_dummy(pos, seat) == brute_force(pos, seat % 2), "solver matches minimax");
+            }
+        }
+
+        static void test_002(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+            using namespace rda::euchre::euchre_algo;
+
+            // solving from the middle of a trick, and evaluating each legal move
+            for (int i = 0; i < 100; ++i)
+            {
+                solver_position pos = random_position(3, static_cast<e_suit>(i % 4));
+                pos.leader_index = static_cast<uint8_t>(i % 4);
+
+                // the leader plays its lowest card index
+                pos.play(euchre_mask::card_from_index(euchre_mask::lowest_index(pos.hands[pos.leader_index])));
+
+                const uint8_t seat = pos.seat_to_play();
+                double_dummy_solver solver(pos, seat);
+                const auto moves = solver.evaluate_moves();
+
+                ASSERT_FALSE(moves.empty(), "there are legal moves");
+
+                uint8_t best = 0;
+                for (auto &m : moves)
+                    best = std::max(best, m.second);
+
+                ASSERT_TRUE(best == solve_double_dummy(pos, seat), "best move value equals position value");
+                ASSERT_TRUE(best == brute_force(pos, seat % 2), "mid-trick solve matches minimax");
+            }
+        }
+
+        static void test_003(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+            using namespace rda::euchre::euchre_algo;
+
+            // full five card deals solve, and the two teams' tricks add up to five
+            for (int i = 0; i < 20; ++i)
+            {
+                solver_position pos = random_position(5, static_cast<e_suit>(i % 4));
+                pos.leader_index = static_cast<uint8_t>(i % 4);
+
+                const uint8_t team0 = solve_double_dummy(pos, 0);
+                const uint8_t team1 = solve_double_dummy(pos, 1);
+
+                ASSERT_TRUE(team0 + team1 == 5, "tricks add up to five");
+            }
+        }
+
+        static void test_004(const size_t testNum, TestInput &input)
+        {
+            using namespace rda::euchre;
+            using namespace rda::euchre::euchre_algo;
+
+            // a tiny shared transposition table (forcing replacements) still gives exact results
+            transposition_table table(8);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                solver_position pos = random_position(4, static_cast<e_suit>(i % 4));
+                pos.leader_index = static_cast<uint8_t>(i % 4);
+
+                for (uint8_t seat = 0; seat < 2; ++seat)
+                {
+                    double_dummy_solver solver(pos, seat, table);
+                    ASSERT_TRUE(solver.solve() == brute_force(pos, seat), "solver with table matches minimax");
+                }
+            }
+
+            // solving the same deal again reuses the stored positions
+            transposition_table large;
+            const solver_position pos = random_position(5, e_suit::SPADES);
+
+            double_dummy_solver first(pos, 0, large);
+            double_dummy_solver second(pos, 0, large);
+
+            ASSERT_TRUE(first.solve() == second.solve(), "same result when solved again");
+            ASSERT_TRUE(second.get_nodes() < first.get_nodes(), "second solve visits fewer positions");
+        }
+
+        static void run_tests()
+        {
+            // vector to hold functions to unit tests
+            std::vector<std::function<void(const size_t, TestInput &)>> test_vec;
+
+            // add all unit tests to the vector
+            test_vec.push_back(test_000);
+            test_vec.push_back(test_001);
+            test_vec.push_back(test_002);
+            test_vec.push_back(test_003);
+            test_vec.push_back(test_004);
+
+            // run each unit test
+            for (size_t i = 0; i < test_vec.size(); ++i)
+            {
+                TestInput input;
+                setup(i, input);
+                test_vec[i](i, input);
+                teardown(i, input);
+            }
+        }
+    } // namespace test_euchre_algo_solver
+} // namespace rda
+
+POP_WARN_DISABLE
@@ -0,0 +1,212 @@
+#pragma once
+
+//
+// work_stealing_pool.h - Thread pool where idle workers steal queued tasks from busy ones
+//
+// Written by Ryan Antkowiak 
+//
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rda
+{
+    // thread pool with one task queue per worker. a worker runs tasks from the back of its own
+    // queue, and when that is empty it steals from the front of the other queues. tasks
+    // submitted from a worker go onto that worker's queue, other tasks are spread round robin.
+    class work_stealing_pool
+    {
+    public:
+        typedef std::function<void()> task;
+
+    private:
+        // a worker's queue of tasks
+        struct task_queue
+        {
+            std::mutex mutex;
+            std::deque<task> tasks;
+        };
+
+        // one queue per worker
+        std::vector<std::unique_ptr<task_queue>> queues;
+
+        // the worker threads
+        std::vector<std::thread> threads;
+
+        // set when the pool is being destroyed
+        std::atomic<bool> stopping{false};
+
+        // number of tasks queued and not yet started
+        std::atomic<size_t> pending{0};
+
+        // queue for the next task submitted from outside the pool
+        std::atomic<size_t> next_queue{0};
+
+        // idle workers sleep here until a task is submitted
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+
+    public:
+        // constructor. starts "num_threads" workers (at least one).
+        explicit work_stealing_pool(const unsigned int num_threads = std::thread::hardware_concurrency())
+        {
+            const unsigned int workers = std::max(1u, num_threads);
+
+            for (unsigned int i = 0; i < workers; ++i)
+                queues.push_back(std::make_unique<task_queue>());
+
+            for (unsigned int i = 0; i < workers; ++i)
+                threads.emplace_back([this, i]() { worker_loop(i); });
+        }
+
+        // no copy constructor
+        work_stealing_pool(const work_stealing_pool &) = delete;
+
+        // no copy assignment
+        work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+        // destructor. tasks still queued are run before the workers exit.
+        ~work_stealing_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                stopping = true;
+            }
+
+            sleep_cv.notify_all();
+
+            for (auto &t : threads)
+                t.join();
+        }
+
+        // return the number of worker threads
+        size_t size() const
+        {
+            return threads.size();
+        }
+
+        // queue a task to run on the pool
+        void submit(task t)
+        {
+            const size_t own = current_worker();
+            const size_t index = (own < queues.size()) ? own : next_queue++ % queues.size();
+
+            // counted before it is queued, so the count never drops below the tasks queued
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                ++pending;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                queues[index]->tasks.push_back(std::move(t));
+            }
+
+            sleep_cv.notify_one();
+        }
+
+        // run one queued task on the calling thread, so a thread waiting for results can help.
+        // returns false if there was no task to run.
+        bool try_run_one()
+        {
+            const size_t own = current_worker();
+            task t;
+
+            if (!take_task((own < queues.size()) ? own : 0, t))
+                return false;
+
+            t();
+            return true;
+        }
+
+        // return the pool shared by the whole program
+        static work_stealing_pool &shared()
+        {
+            static work_stealing_pool pool;
+            return pool;
+        }
+
+    private:
+        // return the index of the worker of this pool running on the calling thread, or a
+        // value past the last worker if the calling thread is not one of them
+        size_t current_worker() const
+        {
+            return (worker_pool() == this) ? worker_index() : queues.size();
+        }
+
+        // pool and worker index of the calling thread
+        static const work_stealing_pool *&worker_pool()
+        {
+            thread_local const work_stealing_pool *pool = nullptr;
+            return pool;
+        }
+
+        static size_t &worker_index()
+        {
+            thread_local size_t index = 0;
+            return index;
+        }
+
+        // take a task, from the back of queue "first" or else from the front of another queue
+        bool take_task(const size_t first, task &t)
+        {
+            for (size_t n = 0; n < queues.size(); ++n)
+            {
+                task_queue &q = *queues[(first + n) % queues.size()];
+                std::lock_guard<std::mutex> lock(q.mutex);
+
+                if (q.tasks.empty())
+                    continue;
+
+                if (n == 0)
+                {
+                    t = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                }
+                else
+                {
+                    t = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                }
+
+                --pending;
+                return true;
+            }
+
+            return false;
+        }
+
+        // run tasks until the pool is destroyed and no tasks are left
+        void worker_loop(const size_t index)
+        {
+            worker_pool() = this;
+            worker_index() = index;
+
+            for (;;)
+            {
+                task t;
+
+                if (take_task(index, t))
+                {
+                    t();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                sleep_cv.wait(lock, [this]() { return stopping || pending > 0; });
+
+                if (stopping && pending == 0)
+                    return;
+            }
+        }
+    };
+
+} // namespace rda